@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <arch.h>
@@ -14,6 +15,7 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
+#include <drivers/auth/crypto_mod.h>
 #include <drivers/io/io_storage.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
@@ -59,6 +61,70 @@ uintptr_t page_align(uintptr_t value, unsigned dir)
 	return value;
 }
 
+#if defined(HASH_WHILE_LOADING) && CRYPTO_SUPPORT
+/* Amount read before each chunk is hashed, small enough to still be in the cache */
+#define LOAD_HASH_CHUNK_SIZE	(64U * 1024U)
+
+/*******************************************************************************
+ * Read an image in chunks and hash each one right after it is read, so that the
+ * crypto module does not have to read the whole image again from memory when it
+ * is authenticated or measured. Falls back to a single read if the crypto
+ * library cannot hash while loading.
+ ******************************************************************************/
+static int read_and_hash(uintptr_t image_handle, uintptr_t image_base,
+			 size_t image_size, size_t *bytes_read)
+{
+	size_t done = 0U;
+	size_t chunk;
+	size_t length_read;
+	bool hashing;
+	int io_result = 0;
+
+	hashing = (crypto_mod_hash_stream_start((void *)image_base,
+						(unsigned int)image_size) == 0);
+
+	while (done < image_size) {
+		chunk = image_size - done;
+		if (hashing && (chunk > LOAD_HASH_CHUNK_SIZE)) {
+			chunk = LOAD_HASH_CHUNK_SIZE;
+		}
+
+		io_result = io_read(image_handle, image_base + done, chunk,
+				    &length_read);
+		if ((io_result != 0) || (length_read == 0U)) {
+			break;
+		}
+
+		if (hashing && (crypto_mod_hash_stream_update(
+					(void *)(image_base + done),
+					(unsigned int)length_read) != 0)) {
+			hashing = false;
+		}
+
+		done += length_read;
+	}
+
+	if (hashing) {
+		(void)crypto_mod_hash_stream_finish();
+	}
+
+	*bytes_read = done;
+
+	return io_result;
+}
+#endif /* HASH_WHILE_LOADING && CRYPTO_SUPPORT */
+
+/*******************************************************************************
+ * Drop the digest computed while loading the last image, so that it is never
+ * matched against whatever is later placed in the same buffer.
+ ******************************************************************************/
+static void discard_load_hash(void)
+{
+#if defined(HASH_WHILE_LOADING) && CRYPTO_SUPPORT
+	crypto_mod_hash_stream_discard();
+#endif
+}
+
 /*******************************************************************************
  * Internal function to load an image at a specific address given
  * an image ID and extents of free memory.
@@ -123,7 +189,11 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
+#if defined(HASH_WHILE_LOADING) && CRYPTO_SUPPORT
+	io_result = read_and_hash(image_handle, image_base, image_size, &bytes_read);
+#else
 	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+#endif
 	if ((io_result != 0) || (bytes_read < image_size)) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
@@ -190,13 +260,23 @@ static int load_auth_image_recursive(unsigned int image_id,
 static int load_auth_image_internal(unsigned int image_id,
 				    image_info_t *image_data)
 {
+	int rc;
+
 #if TRUSTED_BOARD_BOOT
 	if (dyn_is_auth_disabled() == 0) {
-		return load_auth_image_recursive(image_id, image_data, 0);
-	}
+		rc = load_auth_image_recursive(image_id, image_data, 0);
+	} else
 #endif
+	{
+		rc = load_image(image_id, image_data);
+	}
+
+	/* A failed load leaves nothing to authenticate or measure */
+	if (rc != 0) {
+		discard_load_hash();
+	}
 
-	return load_image(image_id, image_data);
+	return rc;
 }
 
 /*******************************************************************************
@@ -230,6 +310,10 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 		 * it (if MEASURED_BOOT flag is enabled).
 		 */
 		err = plat_mboot_measure_image(image_id, image_data);
+
+		/* Authentication and measurement were the only users of the digest */
+		discard_load_hash();
+
 		if (err != 0) {
 			return err;
 		}
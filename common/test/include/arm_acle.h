@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARM_ACLE_H
+#define ARM_ACLE_H
+
+/*
+ * Host build: bitwise versions of the CRC32 instructions, so the
+ * __ARM_FEATURE_CRC32 path of tf_crc32.c runs on any build machine.
+ */
+
+#include <stdint.h>
+
+static inline uint32_t __crc32b(uint32_t crc, uint8_t data)
+{
+	unsigned int k;
+
+	crc ^= data;
+	for (k = 0U; k < 8U; k++)
+		crc = ((crc & 1U) != 0U) ? ((crc >> 1) ^ 0xedb88320U) : (crc >> 1);
+
+	return crc;
+}
+
+static inline uint32_t __crc32d(uint32_t crc, uint64_t data)
+{
+	unsigned int i;
+
+	for (i = 0U; i < 8U; i++)
+		crc = __crc32b(crc, (uint8_t)(data >> (8U * i)));
+
+	return crc;
+}
+
+#endif /* ARM_ACLE_H */
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DEBUG_H
+#define DEBUG_H
+
+/* Host build: stands in for include/common/debug.h, logging is dropped */
+
+#define ERROR(...)	do { } while (0)
+#define NOTICE(...)	do { } while (0)
+#define WARN(...)	do { } while (0)
+#define INFO(...)	do { } while (0)
+#define VERBOSE(...)	do { } while (0)
+
+#endif /* DEBUG_H */
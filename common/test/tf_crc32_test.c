@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host check of tf_crc32() against zlib's crc32(), built once for the
+ * slicing-by-8 path and once for the CRC instruction path (see Makefile).
+ * Lengths cover the interleave threshold and the three-way split, offsets
+ * cover every alignment, and every length is also checked as two chained
+ * calls.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <zlib.h>
+
+#include <common/tf_crc32.h>
+
+#define BUF_SIZE	(1U << 20)
+#define BENCH_RUNS	64U
+
+static const size_t lengths[] = {
+	0, 1, 7, 8, 9, 15, 16, 17, 23, 24, 25, 63, 64, 255, 256, 1000,
+	1023, 1024, 1025, 1031, 1047, 1048, 1049, 2047, 2048, 4095, 4096,
+	65535, 65536, 65537, 100003, BUF_SIZE - 8,
+};
+
+static unsigned int check(const unsigned char *buf, size_t len, size_t split)
+{
+	uint32_t expected = (uint32_t)crc32(0UL, buf, (uInt)len);
+	uint32_t crc;
+	unsigned int failures = 0U;
+
+	crc = tf_crc32(0U, buf, len);
+	if (crc != expected) {
+		printf("FAIL: %zu bytes at offset %lu: 0x%08x, zlib 0x%08x\n",
+		       len, (unsigned long)((uintptr_t)buf & 7U), crc, expected);
+		failures++;
+	}
+
+	crc = tf_crc32(tf_crc32(0U, buf, split), buf + split, len - split);
+	if (crc != expected) {
+		printf("FAIL: %zu bytes at offset %lu split at %zu: 0x%08x, zlib 0x%08x\n",
+		       len, (unsigned long)((uintptr_t)buf & 7U), split, crc, expected);
+		failures++;
+	}
+
+	return failures;
+}
+
+#ifndef __ARM_FEATURE_CRC32
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+#endif
+
+int main(void)
+{
+	unsigned char *mem = malloc(BUF_SIZE + 8U);
+	unsigned int failures = 0U;
+	unsigned int checks = 0U;
+	unsigned int offset;
+	size_t i;
+#ifndef __ARM_FEATURE_CRC32
+	volatile uint32_t sink = 0U;
+	unsigned int run;
+	double t;
+#endif
+
+	if (mem == NULL)
+		return 1;
+
+	srand(1);
+	for (i = 0; i < BUF_SIZE + 8U; i++)
+		mem[i] = (unsigned char)rand();
+
+	for (offset = 0U; offset < 8U; offset++)
+		for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+			failures += check(mem + offset, lengths[i], lengths[i] / 3U);
+			checks += 2U;
+		}
+
+	/* Chaining from a non-zero CRC, as when an image is checked in pieces */
+	for (i = 1; i < 4096; i += 97) {
+		failures += check(mem + 1, BUF_SIZE - 8, i);
+		checks += 2U;
+	}
+
+	printf("tf_crc32 (%s): %u of %u checks passed\n", TF_CRC32_PATH, checks - failures, checks);
+
+#ifndef __ARM_FEATURE_CRC32
+	/* The emulated instructions say nothing about the hardware, only time the tables */
+	t = now();
+	for (run = 0U; run < BENCH_RUNS; run++)
+		sink ^= tf_crc32(0U, mem, BUF_SIZE);
+	t = now() - t;
+	printf("tf_crc32 (%s): %.0f MB/s on the build host\n", TF_CRC32_PATH,
+	       (BENCH_RUNS * (double)BUF_SIZE) / t / 1e6);
+#endif
+
+	free(mem);
+	return (failures == 0U) ? 0 : 1;
+}
@@ -5,18 +5,194 @@
  */
 
 #include <stdarg.h>
+#include <stdbool.h>
 #include <assert.h>
 
 #include <arm_acle.h>
 #include <common/debug.h>
 #include <common/tf_crc32.h>
 
+/* Reflected CRC-32 (IEEE 802.3) polynomial */
+#define CRC32_POLY		0xedb88320U
+
+#ifdef __ARM_FEATURE_CRC32
+/*
+ * Buffers at least this long are split into three parts whose CRCs are
+ * computed in one interleaved loop and then combined, hiding the latency of
+ * the CRC instructions.
+ */
+#define CRC32_INTERLEAVE_MIN	1024U
+
+/* x^(2^n) mod P, in reflected form */
+static const uint32_t x2n_table[32] = {
+	0x40000000U, 0x20000000U, 0x08000000U, 0x00800000U,
+	0x00008000U, 0xedb88320U, 0xb1e6b092U, 0xa06a2517U,
+	0xed627daeU, 0x88d14467U, 0xd7bbfe6aU, 0xec447f11U,
+	0x8e7ea170U, 0x6427800eU, 0x4d47bae0U, 0x09fe548fU,
+	0x83852d0fU, 0x30362f1aU, 0x7b5a9cc3U, 0x31fec169U,
+	0x9fec022aU, 0x6c8dedc4U, 0x15d6874dU, 0x5fde7a4eU,
+	0xbad90e37U, 0x2e4e5eefU, 0x4eaba214U, 0xa8a472c0U,
+	0x429a969eU, 0x148d302aU, 0xc40ba6d0U, 0xc4e22c3cU,
+};
+
+/* Return a * b mod P, in reflected form */
+static uint32_t multmodp(uint32_t a, uint32_t b)
+{
+	uint32_t m = 1U << 31;
+	uint32_t p = 0U;
+
+	for (;;) {
+		if ((a & m) != 0U) {
+			p ^= b;
+			if ((a & (m - 1U)) == 0U)
+				break;
+		}
+		m >>= 1;
+		b = ((b & 1U) != 0U) ? ((b >> 1) ^ CRC32_POLY) : (b >> 1);
+	}
+
+	return p;
+}
+
+/* Return x^(8 * n) mod P, the factor that shifts a CRC over n zero bytes */
+static uint32_t x8nmodp(size_t n)
+{
+	uint32_t p = 1U << 31;
+	unsigned int k = 3U;
+
+	while (n != 0UL) {
+		if ((n & 1UL) != 0UL)
+			p = multmodp(x2n_table[k & 31U], p);
+		n >>= 1;
+		k++;
+	}
+
+	return p;
+}
+
+/* buf is 8 byte aligned, so the load is also safe with the MMU off */
+static inline uint64_t load64(const unsigned char *buf)
+{
+	return *(const uint64_t *)(const void *)buf;
+}
+
+/* Update the (uninverted) CRC over buf using the 8 byte CRC instruction */
+static uint32_t crc32_hw(uint32_t crc, const unsigned char *buf, size_t size)
+{
+	const unsigned char *b0, *b1, *b2;
+	uint32_t crc1 = 0U;
+	uint32_t crc2 = 0U;
+	uint32_t shift;
+	size_t part;
+	size_t i;
+
+	while ((size != 0UL) && (((uintptr_t)buf & 7UL) != 0UL)) {
+		crc = __crc32b(crc, *buf);
+		buf++;
+		size--;
+	}
+
+	if (size >= CRC32_INTERLEAVE_MIN) {
+		part = (size / 24UL) * 8UL;
+		b0 = buf;
+		b1 = buf + part;
+		b2 = buf + (2UL * part);
+		for (i = 0UL; i < part; i += 8UL) {
+			crc = __crc32d(crc, load64(b0 + i));
+			crc1 = __crc32d(crc1, load64(b1 + i));
+			crc2 = __crc32d(crc2, load64(b2 + i));
+		}
+
+		/* crc(A|B|C) = crc(A) * x^(16 * part) ^ crc(B) * x^(8 * part) ^ crc(C) */
+		shift = x8nmodp(part);
+		crc = multmodp(shift, multmodp(shift, crc) ^ crc1) ^ crc2;
+
+		buf += 3UL * part;
+		size -= 3UL * part;
+	}
+
+	while (size >= 8UL) {
+		crc = __crc32d(crc, load64(buf));
+		buf += 8;
+		size -= 8UL;
+	}
+
+	while (size != 0UL) {
+		crc = __crc32b(crc, *buf);
+		buf++;
+		size--;
+	}
+
+	return crc;
+}
+#else
+/* Slicing-by-8 tables, built on first use */
+static uint32_t crc_table[8][256];
+static bool crc_table_ready;
+
+static void crc32_init_table(void)
+{
+	uint32_t c;
+	unsigned int n;
+	unsigned int k;
+
+	for (n = 0U; n < 256U; n++) {
+		c = n;
+		for (k = 0U; k < 8U; k++)
+			c = ((c & 1U) != 0U) ? ((c >> 1) ^ CRC32_POLY) : (c >> 1);
+		crc_table[0][n] = c;
+	}
+
+	for (n = 0U; n < 256U; n++) {
+		c = crc_table[0][n];
+		for (k = 1U; k < 8U; k++) {
+			c = crc_table[0][c & 0xffU] ^ (c >> 8);
+			crc_table[k][n] = c;
+		}
+	}
+
+	crc_table_ready = true;
+}
+
+/* Update the (uninverted) CRC over buf, eight bytes per step */
+static uint32_t crc32_sw(uint32_t crc, const unsigned char *buf, size_t size)
+{
+	uint32_t lo;
+	uint32_t hi;
+
+	if (!crc_table_ready)
+		crc32_init_table();
+
+	while (size >= 8UL) {
+		lo = crc ^ ((uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+			    ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24));
+		hi = (uint32_t)buf[4] | ((uint32_t)buf[5] << 8) |
+		     ((uint32_t)buf[6] << 16) | ((uint32_t)buf[7] << 24);
+		crc = crc_table[7][lo & 0xffU] ^ crc_table[6][(lo >> 8) & 0xffU] ^
+		      crc_table[5][(lo >> 16) & 0xffU] ^ crc_table[4][lo >> 24] ^
+		      crc_table[3][hi & 0xffU] ^ crc_table[2][(hi >> 8) & 0xffU] ^
+		      crc_table[1][(hi >> 16) & 0xffU] ^ crc_table[0][hi >> 24];
+		buf += 8;
+		size -= 8UL;
+	}
+
+	while (size != 0UL) {
+		crc = crc_table[0][(crc ^ *buf) & 0xffU] ^ (crc >> 8);
+		buf++;
+		size--;
+	}
+
+	return crc;
+}
+#endif
+
 /* compute CRC using Arm intrinsic function
  *
  * This function is useful for the platforms with the CPU ARMv8.0
  * (with CRC instructions supported), and onwards.
  * Platforms with CPU ARMv8.0 should make sure to add a compile switch
  * '-march=armv8-a+crc" for successful compilation of this file.
+ * Without the switch a slicing-by-8 table implementation is used instead.
  *
  * @crc: previous accumulated CRC
  * @buf: buffer base address
@@ -28,18 +204,9 @@ uint32_t tf_crc32(uint32_t crc, const unsigned char *buf, size_t size)
 {
 	assert(buf != NULL);
 
-	uint32_t calc_crc = ~crc;
-	const unsigned char *local_buf = buf;
-	size_t local_size = size;
-
-	/*
-	 * calculate CRC over byte data
-	 */
-	while (local_size != 0UL) {
-		calc_crc = __crc32b(calc_crc, *local_buf);
-		local_buf++;
-		local_size--;
-	}
-
-	return ~calc_crc;
+#ifdef __ARM_FEATURE_CRC32
+	return ~crc32_hw(~crc, buf, size);
+#else
+	return ~crc32_sw(~crc, buf, size);
+#endif
 }
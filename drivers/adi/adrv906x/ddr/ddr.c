@@ -32,65 +32,128 @@
 #define DDR_DEBUG(...)
 #endif
 
-/* This functions does a "scrub" of the ECC*, doing a test write to every memory location to update the ECC data and avoid read errors from uninitialized inline ECC bits
- *  Function taken from design team log to scrub the ECC after init before any writes to avoid early ECC errors on read */
-static ddr_error_t ddr_scrub_ecc(uintptr_t base_addr_ctrl, uint32_t ddr_size, bool is_x16)
+/* Returns the scrubber range for the whole physical DDR, excluding the protected region of the inline ECC.
+ * We have to divide the final size by 2 if the DDR is an x16, after subtracting (size of inline ecc range + 1)
+ * from the range, x8 can just use size in bytes -1 */
+static uint32_t ddr_scrub_range(uint32_t ddr_size, bool is_x16)
+{
+	if (is_x16)
+		return ((ddr_size - (ddr_size >> 3)) / 2) - 1;
+	else
+		return (ddr_size - (ddr_size >> 3)) - 1;
+}
+
+/* Runs one back-to-back scrubber pass over [0, scrub_size] with the AXI ports blocked. A write pass fills
+ * the range with wdata (updating the inline ECC), a read pass reads it back through the ECC checker. */
+static ddr_error_t ddr_scrubber_pass(uintptr_t base_addr_ctrl, uint32_t scrub_size, bool write, uint32_t wdata)
 {
 	uint32_t scrubber_data;
-	uint32_t scrub_size;
 	int i;
 
-	/* We have to divide the final size by 2 if the DDR is an x16,
-	 * after subtracting (size of inline ecc range + 1) from the range
-	 * to avoid scrubbing the protected region of the inline ECC since we are scrubbing the full physical DDR always */
-	if (is_x16)
-		scrub_size = ((ddr_size - (ddr_size >> 3)) / 2) - 1;
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRWDATA0, wdata);
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRSTART0, 0x0);
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRRANGE0, scrub_size);
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_PCTRL_0, 0x0);
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_PCTRL_1, 0x0);
+	scrubber_data = mmio_read_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRCTL);
+	scrubber_data |= SBRCTL_SCRUB_EN_MASK;
+	if (write)
+		scrubber_data |= SBRCTL_SCRUB_MODE_MASK;
 	else
-		/* x8 can just use size in bytes -1 to avoid protected region */
-		scrub_size = (ddr_size - (ddr_size >> 3)) - 1;
+		scrubber_data &= ~SBRCTL_SCRUB_MODE_MASK;
+	scrubber_data &= ~SBRCTL_SCRUB_INTERVAL_MASK;
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRCTL, scrubber_data);
+	for (i = 0; i < ADI_DDR_ECC_SCRUB_TIMEOUT; i++) {
+		if (((mmio_read_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRSTAT) & SBRSTAT_SCRUB_DONE_MASK) >> SBRSTAT_SCRUB_DONE_SHIFT) == 0x1)
+			break;
+		mdelay(1);
+	}
 
-	DDR_DEBUG("Beginning DDR scrub.\n");
-	if (!plat_is_sysc()) {
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRWDATA0, 0x0000DEAF);
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRSTART0, 0x0);
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRRANGE0, scrub_size);
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_PCTRL_0, 0x0);
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_PCTRL_1, 0x0);
-		scrubber_data = mmio_read_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRCTL);
-		scrubber_data |= 0x5;
-		scrubber_data &= 0xFFE000FF;
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRCTL, scrubber_data);
-		for (i = 0; i < ADI_DDR_ECC_SCRUB_TIMEOUT; i++) {
-			if (((mmio_read_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRSTAT) & SBRSTAT_SCRUB_DONE_MASK) >> SBRSTAT_SCRUB_DONE_SHIFT) == 0x1)
-				break;
-			mdelay(1);
-		}
+	if (i == ADI_DDR_ECC_SCRUB_TIMEOUT)
+		return ERROR_DDR_ECC_SCRUB_FAILED;
 
-		if (i == ADI_DDR_ECC_SCRUB_TIMEOUT)
-			return ERROR_DDR_ECC_SCRUB_FAILED;
 
+	for (i = 0; i < ADI_DDR_CTRL_TIMEOUT; i++) {
+		if (((mmio_read_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRSTAT) & SBRSTAT_SCRUB_BUSY_MASK) >> SBRSTAT_SCRUB_BUSY_SHIFT) == 0x0)
+			break;
+		mdelay(1);
+	}
 
-		for (i = 0; i < ADI_DDR_CTRL_TIMEOUT; i++) {
-			if (((mmio_read_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRSTAT) & SBRSTAT_SCRUB_BUSY_MASK) >> SBRSTAT_SCRUB_BUSY_SHIFT) == 0x0)
-				break;
-			mdelay(1);
-		}
+	if (i == ADI_DDR_CTRL_TIMEOUT)
+		return ERROR_DDR_ECC_SCRUB_FAILED;
 
-		if (i == ADI_DDR_CTRL_TIMEOUT)
-			return ERROR_DDR_ECC_SCRUB_FAILED;
+	scrubber_data = mmio_read_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRCTL);
+	scrubber_data &= ~SBRCTL_SCRUB_EN_MASK;
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRCTL, scrubber_data);
+
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_PCTRL_0, 0x400000FF);
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_PCTRL_1, 0x400000FF);
+
+	return ERROR_DDR_NO_ERROR;
+}
 
-		scrubber_data = mmio_read_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRCTL);
-		scrubber_data &= 0xFFFFFFFE;
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_SBRCTL, scrubber_data);
+/* This functions does a "scrub" of the ECC*, doing a test write to every memory location to update the ECC data and avoid read errors from uninitialized inline ECC bits
+ *  Function taken from design team log to scrub the ECC after init before any writes to avoid early ECC errors on read */
+static ddr_error_t ddr_scrub_ecc(uintptr_t base_addr_ctrl, uint32_t ddr_size, bool is_x16)
+{
+	ddr_error_t rtn_val;
 
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_PCTRL_0, 0x400000FF);
-		mmio_write_32(base_addr_ctrl + DDR_UMCTL2_MP_PCTRL_1, 0x400000FF);
+	DDR_DEBUG("Beginning DDR scrub.\n");
+	if (!plat_is_sysc()) {
+		rtn_val = ddr_scrubber_pass(base_addr_ctrl, ddr_scrub_range(ddr_size, is_x16), true, 0x0000DEAF);
+		if (rtn_val != ERROR_DDR_NO_ERROR)
+			return rtn_val;
 	}
 
 	DDR_DEBUG("DDR ECC scrub complete.\n");
 	return ERROR_DDR_NO_ERROR;
 }
 
+/* Built-in self test using the scrubber instead of CPU loads and stores, so the whole DDR is tested at
+ * controller bandwidth. For each pattern a write pass fills the DDR and a read pass reads it back through
+ * the inline ECC checker. The scrubber does not compare data, so failures are reported as the ECC error
+ * counts of the read passes, which requires ECC to be enabled. Leaves the ECC initialized, but
+ * overwrites the whole DDR. */
+ddr_error_t ddr_bist_mem_test(uintptr_t base_addr_ctrl, uint32_t ddr_size, ddr_config_t configuration, const uint32_t *patterns, unsigned int num_patterns, ddr_bist_result_t *result)
+{
+	ddr_error_t rtn_val = ERROR_DDR_NO_ERROR;
+	uint32_t scrub_size;
+	uint16_t corrected;
+	uint16_t uncorrected;
+	unsigned int i;
+	bool is_x16;
+
+	if (configuration == DDR_PRIMARY_CONFIGURATION)
+		is_x16 = DDR_PRIMARY_ECC_ISX16;
+	else
+		is_x16 = DDR_SECONDARY_ECC_ISX16;
+	scrub_size = ddr_scrub_range(ddr_size, is_x16);
+
+	ddr_clear_ecc_error_counts(base_addr_ctrl);
+
+	for (i = 0; i < num_patterns; i++) {
+		rtn_val = ddr_scrubber_pass(base_addr_ctrl, scrub_size, true, patterns[i]);
+		if (rtn_val == ERROR_DDR_NO_ERROR)
+			rtn_val = ddr_scrubber_pass(base_addr_ctrl, scrub_size, false, 0);
+		if (rtn_val != ERROR_DDR_NO_ERROR)
+			return rtn_val;
+
+		ddr_get_ecc_error_counts(base_addr_ctrl, &corrected, &uncorrected);
+		DDR_DEBUG("DDR BIST pattern 0x%x: %d correctable, %d uncorrectable\n", patterns[i], corrected, uncorrected);
+		if (((corrected != 0U) || (uncorrected != 0U)) && !result->failed) {
+			result->failed = true;
+			result->first_fail_pattern = patterns[i];
+			if (!ddr_get_ecc_error_info(base_addr_ctrl, false, &result->first_error))
+				ddr_get_ecc_error_info(base_addr_ctrl, true, &result->first_error);
+		}
+		result->corrected += corrected;
+		result->uncorrected += uncorrected;
+		ddr_clear_ecc_error_counts(base_addr_ctrl);
+	}
+
+	return result->failed ? ERROR_DDR_BIST_FAILED : ERROR_DDR_NO_ERROR;
+}
+
 /* Basic memory test for the DDR. Note: This test can only be run in BL2 */
 ddr_error_t ddr_basic_mem_test(uintptr_t base_addr_ddr, uint32_t size, bool restore)
 {
@@ -255,6 +318,112 @@ ddr_error_t ddr_extensive_mem_test(uintptr_t base_addr_ddr, uint32_t size)
 	return return_val;
 }
 
+/* NEON block loops, see aarch64/ddr_mem_test_simd.S */
+void ddr_simd_fill(uintptr_t start, uintptr_t end, uint64_t lo, uint64_t hi, uint64_t step);
+uintptr_t ddr_simd_verify(uintptr_t start, uintptr_t end, uint64_t lo, uint64_t hi, uint64_t step);
+uintptr_t ddr_simd_march_up(uintptr_t start, uintptr_t end, uint64_t expect, uint64_t write);
+uintptr_t ddr_simd_march_down(uintptr_t start, uintptr_t end, uint64_t expect, uint64_t write);
+
+#define DDR_CHECKERBOARD_A      (0x5555555555555555ULL)
+#define DDR_CHECKERBOARD_B      (0xAAAAAAAAAAAAAAAAULL)
+
+static void ddr_simd_record_failure(ddr_mem_test_result_t *result, uintptr_t addr, uint32_t pattern)
+{
+	if (result->errors == 0U) {
+		result->first_fail = addr;
+		result->first_fail_pattern = pattern;
+	}
+	result->errors++;
+}
+
+/* Verify a ddr_simd_fill() pattern, counting every failing block rather than stopping at the first */
+static void ddr_simd_verify_range(uintptr_t start, uintptr_t end, uint64_t lo, uint64_t hi, uint64_t step, uint32_t pattern, ddr_mem_test_result_t *result)
+{
+	uintptr_t addr = start;
+	uintptr_t fail;
+	uint64_t adjust;
+
+	while (addr < end) {
+		fail = ddr_simd_verify(addr, end, lo, hi, step);
+		if (fail == end)
+			break;
+		ddr_simd_record_failure(result, fail, pattern);
+
+		/* Resume after the failing block with the pattern it would have had */
+		adjust = ((fail + DDR_MEM_TEST_ALIGN - addr) / 16U) * step;
+		lo += adjust;
+		hi += adjust;
+		addr = fail + DDR_MEM_TEST_ALIGN;
+	}
+}
+
+/* MATS+ march: write 0, ascending read 0/write 1, descending read 1/write 0 */
+static void ddr_simd_mats_plus(uintptr_t start, uintptr_t end, ddr_mem_test_result_t *result)
+{
+	uintptr_t addr;
+	uintptr_t fail;
+
+	ddr_simd_fill(start, end, 0U, 0U, 0U);
+
+	addr = start;
+	while (addr < end) {
+		fail = ddr_simd_march_up(addr, end, 0U, ~0ULL);
+		if (fail == end)
+			break;
+		/* Complete the element on the failing block so the next one starts clean */
+		ddr_simd_record_failure(result, fail, DDR_MEM_TEST_MATS_PLUS);
+		ddr_simd_fill(fail, fail + DDR_MEM_TEST_ALIGN, ~0ULL, ~0ULL, 0U);
+		addr = fail + DDR_MEM_TEST_ALIGN;
+	}
+
+	addr = end;
+	while (addr > start) {
+		fail = ddr_simd_march_down(start, addr, ~0ULL, 0U);
+		if (fail == addr)
+			break;
+		ddr_simd_record_failure(result, fail, DDR_MEM_TEST_MATS_PLUS);
+		ddr_simd_fill(fail, fail + DDR_MEM_TEST_ALIGN, 0U, 0U, 0U);
+		addr = fail;
+	}
+}
+
+/*
+ * Runs the selected DDR_MEM_TEST_* patterns over [base_addr_ddr, base_addr_ddr + size)
+ * using 128-bit accesses. Failures are counted per 64 byte block and testing carries on
+ * past them, so result describes the whole range. The caller must have disabled the
+ * MMU (data cache flushed) and aligned base and size to DDR_MEM_TEST_ALIGN.
+ * Does not print, so that it can run on several cores at once.
+ */
+void ddr_simd_mem_test(uintptr_t base_addr_ddr, uint64_t size, uint32_t patterns, ddr_mem_test_result_t *result)
+{
+	uintptr_t end = base_addr_ddr + size;
+
+	result->errors = 0U;
+	result->first_fail = 0U;
+	result->first_fail_pattern = 0U;
+
+	if (size == 0U)
+		return;
+
+	if ((patterns & DDR_MEM_TEST_MATS_PLUS) != 0U)
+		ddr_simd_mats_plus(base_addr_ddr, end, result);
+
+	if ((patterns & DDR_MEM_TEST_CHECKERBOARD) != 0U) {
+		ddr_simd_fill(base_addr_ddr, end, DDR_CHECKERBOARD_A, DDR_CHECKERBOARD_B, 0U);
+		ddr_simd_verify_range(base_addr_ddr, end, DDR_CHECKERBOARD_A, DDR_CHECKERBOARD_B, 0U, DDR_MEM_TEST_CHECKERBOARD, result);
+		ddr_simd_fill(base_addr_ddr, end, DDR_CHECKERBOARD_B, DDR_CHECKERBOARD_A, 0U);
+		ddr_simd_verify_range(base_addr_ddr, end, DDR_CHECKERBOARD_B, DDR_CHECKERBOARD_A, 0U, DDR_MEM_TEST_CHECKERBOARD, result);
+	}
+
+	if ((patterns & DDR_MEM_TEST_ADDRESS) != 0U) {
+		/* Each 64-bit word holds its own address, then the complement of it */
+		ddr_simd_fill(base_addr_ddr, end, base_addr_ddr, base_addr_ddr + 8U, 16U);
+		ddr_simd_verify_range(base_addr_ddr, end, base_addr_ddr, base_addr_ddr + 8U, 16U, DDR_MEM_TEST_ADDRESS, result);
+		ddr_simd_fill(base_addr_ddr, end, ~base_addr_ddr, ~(base_addr_ddr + 8U), -16ULL);
+		ddr_simd_verify_range(base_addr_ddr, end, ~base_addr_ddr, ~(base_addr_ddr + 8U), -16ULL, DDR_MEM_TEST_ADDRESS, result);
+	}
+}
+
 /* Configures the SARBASE and SARSIZE registers for the DDR based on provided base address and size */
 static ddr_error_t ddr_configure_remapping_registers(uintptr_t base_addr_ctrl, uintptr_t base_addr_ddr, uint32_t ddr_size)
 {
@@ -5,6 +5,7 @@
 #
 
 DDR_SOURCES		:=	drivers/adi/adrv906x/ddr/aarch64/adrv906x_ddr_mem.S\
+				drivers/adi/adrv906x/ddr/aarch64/ddr_mem_test_simd.S \
 				drivers/adi/adrv906x/ddr/ddr.c \
 				drivers/adi/adrv906x/ddr/ddr_config.c \
 				drivers/adi/adrv906x/ddr/ddr_debug.c \
@@ -54,6 +54,23 @@ void ddr_clear_ap_error(uintptr_t base_addr_ctrl)
 	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_REGS_ECCCTL, register_data);
 }
 
+/* Returns both ECC error counters */
+void ddr_get_ecc_error_counts(uintptr_t base_addr_ctrl, uint16_t *corrected, uint16_t *uncorrected)
+{
+	*corrected = ddr_get_correctable_error_count(base_addr_ctrl);
+	*uncorrected = ddr_get_uncorrectable_error_count(base_addr_ctrl);
+}
+
+/* Clears both ECC error counters */
+void ddr_clear_ecc_error_counts(uintptr_t base_addr_ctrl)
+{
+	uint32_t register_data;
+
+	register_data = mmio_read_32(base_addr_ctrl + DDR_UMCTL2_REGS_ECCCTL);
+	register_data |= ECCCTL_ECC_CORR_ERR_CNT_CLR_MASK | ECCCTL_ECC_UNCORR_ERR_CNT_CLR_MASK;
+	mmio_write_32(base_addr_ctrl + DDR_UMCTL2_REGS_ECCCTL, register_data);
+}
+
 /* Retrieves the info(row, bank, etc.) of an ECC error */
 bool ddr_get_ecc_error_info(uintptr_t base_addr_ctrl, bool correctable, ddr_ecc_error_data_t *data)
 {
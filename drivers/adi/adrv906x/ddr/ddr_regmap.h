@@ -3069,6 +3069,12 @@
 #define RFSHTMG_T_RFC_MIN_SHIFT 0
 #define RFSHTMG_T_RFC_NOM_X1_X32_MASK   0x0FFF0000
 #define RFSHTMG_T_RFC_NOM_X1_X32_SHIFT  16
+#define SBRCTL_SCRUB_EN_MASK    0x00000001
+#define SBRCTL_SCRUB_EN_SHIFT   0
+#define SBRCTL_SCRUB_MODE_MASK  0x00000004
+#define SBRCTL_SCRUB_MODE_SHIFT 2
+#define SBRCTL_SCRUB_INTERVAL_MASK      0x001FFF00
+#define SBRCTL_SCRUB_INTERVAL_SHIFT     8
 #define SBRSTAT_SCRUB_BUSY_MASK 0x00000001
 #define SBRSTAT_SCRUB_BUSY_SHIFT        0
 #define SBRSTAT_SCRUB_DONE_MASK 0x00000002
@@ -6,7 +6,7 @@
 
 #include <common/debug.h>
 #include <drivers/adi/adi_c2cc.h>
-#include "adi_c2cc_analysis.h"
+#include <drivers/adi/adi_c2cc_analysis.h>
 #include "adi_c2cc_util.h"
 
 /* Background calibration */
@@ -23,33 +23,73 @@ static void adi_c2cc_phydig_enable(bool enable)
 	ADI_C2CC_WRITE_PHYDIG_LPBK_EN(adi_c2cc_primary_addr_base, enable);
 }
 
-bool adi_c2cc_enable_high_speed(struct adi_c2cc_training_settings *params)
+static bool adi_c2cc_train(uint8_t step, uint32_t *p2s_stats, uint32_t *s2p_stats, uint8_t *p2s_trim_delays, uint8_t *s2p_trim_delays)
+{
+	if (step > 1)
+		return adi_c2cc_run_train_coarse(p2s_stats, s2p_stats, p2s_trim_delays, s2p_trim_delays, step);
+
+	return adi_c2cc_run_train(p2s_stats, s2p_stats, p2s_trim_delays, s2p_trim_delays);
+}
+
+/* Train the lane delays, then the trims, sweeping every step-th trim */
+static bool adi_c2cc_train_trims(uint8_t step, struct adi_c2cc_trim_settings *trims)
 {
 	uint32_t p2s_stats[ADI_C2C_TRIM_MAX];
 	uint32_t s2p_stats[ADI_C2C_TRIM_MAX];
-	uint8_t p2s_trim_delays[ADI_C2C_LANE_COUNT] = { 0 };
-	uint8_t s2p_trim_delays[ADI_C2C_LANE_COUNT] = { 0 };
-	uint8_t p2s_trim = ADI_C2C_TRIM_MAX;
-	uint8_t s2p_trim = ADI_C2C_TRIM_MAX;
 
-	if (!adi_c2cc_setup_train(params))
+	if (!adi_c2cc_train(step, p2s_stats, s2p_stats, trims->p2s_delays, trims->s2p_delays))
 		return false;
 
-	if (!adi_c2cc_run_train(p2s_stats, s2p_stats, p2s_trim_delays, s2p_trim_delays))
+	if (!adi_c2cc_analyze_train_data(p2s_stats, s2p_stats, ADI_C2C_MIN_WINDOW_SIZE, ADI_C2C_TRIM_DELAY_MAX, ADI_C2C_MAX_TRIM_CENTER, trims->p2s_delays, trims->s2p_delays, NULL, NULL))
 		return false;
 
-	if (!adi_c2cc_analyze_train_data(p2s_stats, s2p_stats, ADI_C2C_MIN_WINDOW_SIZE, ADI_C2C_TRIM_DELAY_MAX, ADI_C2C_MAX_TRIM_CENTER, p2s_trim_delays, s2p_trim_delays, NULL, NULL))
+	if (!adi_c2cc_train(step, p2s_stats, s2p_stats, trims->p2s_delays, trims->s2p_delays))
 		return false;
 
-	if (!adi_c2cc_run_train(p2s_stats, s2p_stats, p2s_trim_delays, s2p_trim_delays))
+	return adi_c2cc_analyze_train_data(p2s_stats, s2p_stats, ADI_C2C_MIN_WINDOW_SIZE, ADI_C2C_TRIM_DELAY_MAX, ADI_C2C_MAX_TRIM_CENTER, NULL, NULL, &trims->p2s_trim, &trims->s2p_trim);
+}
+
+bool adi_c2cc_enable_high_speed(struct adi_c2cc_training_settings *params, const struct adi_c2cc_trim_settings *known, struct adi_c2cc_trim_settings *result)
+{
+	const struct adi_c2cc_trim_settings untrained = {
+		.p2s_trim	= ADI_C2C_TRIM_MAX,
+		.s2p_trim	= ADI_C2C_TRIM_MAX,
+	};
+	struct adi_c2cc_trim_settings trims = untrained;
+
+	if (!adi_c2cc_setup_train(params))
 		return false;
 
-	if (!adi_c2cc_analyze_train_data(p2s_stats, s2p_stats, ADI_C2C_MIN_WINDOW_SIZE, ADI_C2C_TRIM_DELAY_MAX, ADI_C2C_MAX_TRIM_CENTER, NULL, NULL, &p2s_trim, &s2p_trim))
+	/* Reuse the trims of an earlier training if the eye is still open around them */
+	if (known != NULL && adi_c2cc_verify_training(known, ADI_C2C_VERIFY_MARGIN)) {
+		INFO("%s: C2CC reusing stored trims.\n", __func__);
+		trims = *known;
+		goto apply;
+	}
+
+	/*
+	 * The coarse sweep fills the gaps between sampled trims, so it cannot
+	 * see a failure inside the eye. Measure the trims it picked and fall
+	 * back to the exhaustive sweep if they do not hold.
+	 */
+	if (params->coarse_step > 1) {
+		if (adi_c2cc_train_trims(params->coarse_step, &trims) &&
+		    adi_c2cc_verify_training(&trims, ADI_C2C_VERIFY_MARGIN))
+			goto apply;
+		WARN("%s: C2CC coarse trims failed, running the full sweep.\n", __func__);
+		trims = untrained;
+	}
+
+	if (!adi_c2cc_train_trims(1, &trims))
 		return false;
 
-	if (!adi_c2cc_apply_training(p2s_trim, s2p_trim, &params->tx_clk))
+apply:
+	if (!adi_c2cc_apply_training(trims.p2s_trim, trims.s2p_trim, &params->tx_clk))
 		return false;
 
+	if (result != NULL)
+		*result = trims;
+
 	INFO("%s: C2CC phy training complete.\n", __func__);
 	return true;
 }
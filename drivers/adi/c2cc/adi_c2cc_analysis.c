@@ -5,7 +5,9 @@
  */
 
 #include <common/debug.h>
+#include <lib/utils_def.h>
 #include <drivers/adi/adi_c2cc.h>
+#include <drivers/adi/adi_c2cc_analysis.h>
 
 /**
  * searching through the combined data only, find the largest available
@@ -458,3 +460,67 @@ uint8_t adi_c2cc_find_optimal_trim(uint32_t *stats, size_t min_size, size_t max_
 
 	return ADI_C2C_TRIM_MAX;
 }
+
+/* Return a bit per lane that saw errors in the combined statistics */
+static uint8_t adi_c2cc_lane_fail_mask(uint32_t stat)
+{
+	uint8_t mask = 0;
+	unsigned int i = 0;
+
+	for (i = 0; i < ADI_C2C_LANE_COUNT; i++)
+		if ((stat >> (8 * i)) & 0xFF)
+			mask |= 1U << i;
+
+	return mask;
+}
+
+/**
+ * fill the statistics of all trims while measuring as few as possible.
+ * Every step-th trim is measured, plus the last one so every gap is bounded.
+ * A gap whose ends fail on the same lanes in both directions takes the
+ * statistics of its start, otherwise every trim in it is measured.
+ * @param[out] p2s_stats - the primary-to-secondary statistics of every trim.
+ * @param[out] s2p_stats - the secondary-to-primary statistics of every trim.
+ * @param[in] step - the trim step of the first pass.
+ * @param[in] p2s_only - only compare the primary-to-secondary statistics
+ *                       (loopback mode).
+ * @param[in] measure - gathers the statistics of one trim.
+ * @param[out] measured - the number of trims measured.
+ * @return true if all statistics were filled, false if a measure failed.
+ */
+bool adi_c2cc_coarse_sweep(uint32_t *p2s_stats, uint32_t *s2p_stats, unsigned int step, bool p2s_only, adi_c2cc_measure_fn_t measure, unsigned int *measured)
+{
+	unsigned int prev = 0;
+	unsigned int trim = 0;
+	unsigned int i = 0;
+	bool same = false;
+
+	*measured = 0;
+
+	for (trim = 0; trim < ADI_C2C_TRIM_MAX; trim = (trim == ADI_C2C_TRIM_MAX - 1) ? ADI_C2C_TRIM_MAX : MIN(trim + step, ADI_C2C_TRIM_MAX - 1U)) {
+		if (!measure(trim, &p2s_stats[trim], &s2p_stats[trim]))
+			return false;
+		(*measured)++;
+
+		if (trim > prev + 1) {
+			same = adi_c2cc_lane_fail_mask(p2s_stats[prev]) == adi_c2cc_lane_fail_mask(p2s_stats[trim]);
+			if (!p2s_only)
+				same = same && (adi_c2cc_lane_fail_mask(s2p_stats[prev]) == adi_c2cc_lane_fail_mask(s2p_stats[trim]));
+
+			for (i = prev + 1; i < trim; i++) {
+				if (same) {
+					p2s_stats[i] = p2s_stats[prev];
+					if (!p2s_only)
+						s2p_stats[i] = s2p_stats[prev];
+					continue;
+				}
+				if (!measure(i, &p2s_stats[i], &s2p_stats[i]))
+					return false;
+				(*measured)++;
+			}
+		}
+		prev = trim;
+	}
+
+	return true;
+}
@@ -6,8 +6,9 @@
 
 #include <common/debug.h>
 #include <drivers/delay_timer.h>
+#include <lib/utils_def.h>
 #include <drivers/adi/adi_c2cc.h>
-#include "adi_c2cc_analysis.h"
+#include <drivers/adi/adi_c2cc_analysis.h>
 #include "adi_c2cc_util.h"
 
 /* Low speed (20 MHz) settings */
@@ -122,6 +123,40 @@ static bool adi_c2cc_s2p_gather_statistics(uintptr_t sec_base, uintptr_t pri_bas
 	return true;
 }
 
+/**
+ * run the LFSR in both directions for one trim value each and collect the
+ * results. Each direction keeps its own AXI bridge ordering, the secondary is
+ * only accessed while the primary bridge is enabled.
+ * @param[in] pri_base - base address for the primary c2cc.
+ * @param[in] sec_base - base address for the secondary c2cc.
+ * @param[in] p2s_trim - the secondary rx clock trim value to test.
+ * @param[in] s2p_trim - the primary rx clock trim value to test (unused in loopback mode).
+ * @param[out] p2s_stat - the primary-to-secondary statistics for p2s_trim.
+ * @param[out] s2p_stat - the secondary-to-primary statistics for s2p_trim.
+ * @return true if statistics were gathered, false if error.
+ */
+static bool adi_c2cc_gather_statistics(uintptr_t pri_base, uintptr_t sec_base, uint8_t p2s_trim, uint8_t s2p_trim, uint32_t *p2s_stat, uint32_t *s2p_stat)
+{
+	if (!adi_c2cc_p2s_gather_statistics(pri_base, sec_base, p2s_trim, p2s_stat))
+		return false;
+
+	if (adi_c2cc_loopback)
+		return true;
+
+	return adi_c2cc_s2p_gather_statistics(sec_base, pri_base, s2p_trim, s2p_stat);
+}
+
+/* Measure one trim for the coarse sweep */
+static bool adi_c2cc_measure_trim(uint8_t trim, uint32_t *p2s_stat, uint32_t *s2p_stat)
+{
+	if (!adi_c2cc_gather_statistics(adi_c2cc_primary_addr_base, adi_c2cc_secondary_addr_base, trim, trim, p2s_stat, s2p_stat)) {
+		ERROR("%s: C2CC timeout while gathering statistics (trim=%u).\n", __func__, trim);
+		return false;
+	}
+
+	return true;
+}
+
 static void adi_c2cc_configure_tx_clk(uintptr_t pri_base, uintptr_t sec_base, struct adi_c2cc_training_clock_settings *tx_clk)
 {
 	/* Set low speed (20MHz) before training procedure
@@ -205,6 +240,12 @@ bool adi_c2cc_setup_train(struct adi_c2cc_training_settings *params)
 		return false;
 	}
 
+	/* a coarse pass must land in every eye wide enough to be selected */
+	if (params->coarse_step >= ADI_C2C_MIN_WINDOW_SIZE) {
+		ERROR("%s: C2CC coarse trim step too large.\n", __func__);
+		return false;
+	}
+
 	adi_c2cc_configure_tx_clk(pri_base, sec_base, &params->tx_clk);                 /* clock divisors */
 	adi_c2cc_configure_generator(pri_base, sec_base, &params->generator);           /* polynomial and seed */
 	adi_c2cc_configure_delay(pri_base, sec_base, &params->p2s_delay);               /* primary-to-secondary */
@@ -214,18 +255,10 @@ bool adi_c2cc_setup_train(struct adi_c2cc_training_settings *params)
 	return true;
 }
 
-bool adi_c2cc_run_train(uint32_t *p2s_stats, uint32_t *s2p_stats, uint8_t *p2s_trim_delays, uint8_t *s2p_trim_delays)
+static void adi_c2cc_begin_train(uintptr_t pri_base, uintptr_t sec_base, const uint8_t *p2s_trim_delays, const uint8_t *s2p_trim_delays)
 {
-	uintptr_t pri_base = adi_c2cc_primary_addr_base;
-	uintptr_t sec_base = adi_c2cc_secondary_addr_base;
-	uint8_t trim = 0;
 	unsigned int i = 0;
 
-	if ((p2s_trim_delays == NULL) || (s2p_trim_delays == NULL) || (p2s_stats == NULL) || (s2p_stats == NULL)) {
-		ERROR("%s: C2CC invalid statistics parameters.\n", __func__);
-		return false;
-	}
-
 	for (i = 0; i < ADI_C2C_LANE_COUNT; i++) {
 		ADI_C2CC_WRITE_TXDATA_DELAY(pri_base, i, p2s_trim_delays[i]);
 		ADI_C2CC_WRITE_RXDATA_DELAY(pri_base, i, s2p_trim_delays[i]);
@@ -234,6 +267,20 @@ bool adi_c2cc_run_train(uint32_t *p2s_stats, uint32_t *s2p_stats, uint8_t *p2s_t
 	/* disable bridged interrupts */
 	ADI_C2CC_WRITE_INT_EN(sec_base, 0);
 	ADI_C2CC_WRITE_INT_EN(pri_base, 0);
+}
+
+bool adi_c2cc_run_train(uint32_t *p2s_stats, uint32_t *s2p_stats, uint8_t *p2s_trim_delays, uint8_t *s2p_trim_delays)
+{
+	uintptr_t pri_base = adi_c2cc_primary_addr_base;
+	uintptr_t sec_base = adi_c2cc_secondary_addr_base;
+	uint8_t trim = 0;
+
+	if ((p2s_trim_delays == NULL) || (s2p_trim_delays == NULL) || (p2s_stats == NULL) || (s2p_stats == NULL)) {
+		ERROR("%s: C2CC invalid statistics parameters.\n", __func__);
+		return false;
+	}
+
+	adi_c2cc_begin_train(pri_base, sec_base, p2s_trim_delays, s2p_trim_delays);
 
 	VERBOSE("%s: C2CC gathering primary (Tx) to secondary (Rx) statistics.\n", __func__);
 	for (trim = 0; trim < ADI_C2C_TRIM_MAX; trim++) {
@@ -263,6 +310,73 @@ bool adi_c2cc_run_train(uint32_t *p2s_stats, uint32_t *s2p_stats, uint8_t *p2s_t
 	return true;
 }
 
+bool adi_c2cc_run_train_coarse(uint32_t *p2s_stats, uint32_t *s2p_stats, uint8_t *p2s_trim_delays, uint8_t *s2p_trim_delays, unsigned int step)
+{
+	uintptr_t pri_base = adi_c2cc_primary_addr_base;
+	uintptr_t sec_base = adi_c2cc_secondary_addr_base;
+	unsigned int measured = 0;
+	bool ret = false;
+
+	if ((p2s_trim_delays == NULL) || (s2p_trim_delays == NULL) || (p2s_stats == NULL) || (s2p_stats == NULL) || (step == 0)) {
+		ERROR("%s: C2CC invalid statistics parameters.\n", __func__);
+		return false;
+	}
+
+	adi_c2cc_begin_train(pri_base, sec_base, p2s_trim_delays, s2p_trim_delays);
+
+	VERBOSE("%s: C2CC gathering statistics, coarse step %u.\n", __func__, step);
+	ret = adi_c2cc_coarse_sweep(p2s_stats, s2p_stats, step, adi_c2cc_loopback, adi_c2cc_measure_trim, &measured);
+	if (ret)
+		VERBOSE("%s: C2CC measured %u of %u trims.\n", __func__, measured, ADI_C2C_TRIM_MAX);
+
+	/* re-enable bridged interrupts */
+	ADI_C2CC_WRITE_INT_EN(pri_base, 1);
+	ADI_C2CC_WRITE_INT_EN(sec_base, 1);
+
+	return ret;
+}
+
+bool adi_c2cc_verify_training(const struct adi_c2cc_trim_settings *trims, unsigned int margin)
+{
+	uintptr_t pri_base = adi_c2cc_primary_addr_base;
+	uintptr_t sec_base = adi_c2cc_secondary_addr_base;
+	uint32_t p2s_stat = 0;
+	uint32_t s2p_stat = 0;
+	int offset = 0;
+	int lowest = 0;
+	int highest = 0;
+	bool ret = true;
+
+	if (trims == NULL) {
+		ERROR("%s: C2CC invalid trim parameters.\n", __func__);
+		return false;
+	}
+
+	/* the whole margin must fit in the trim range */
+	lowest = adi_c2cc_loopback ? trims->p2s_trim : MIN(trims->p2s_trim, trims->s2p_trim);
+	highest = adi_c2cc_loopback ? trims->p2s_trim : MAX(trims->p2s_trim, trims->s2p_trim);
+	if ((lowest < (int)margin) || (highest + (int)margin >= ADI_C2C_TRIM_MAX))
+		return false;
+
+	adi_c2cc_begin_train(pri_base, sec_base, trims->p2s_delays, trims->s2p_delays);
+
+	/* The eye must still be open for margin trims either side of the stored ones */
+	for (offset = -(int)margin; offset <= (int)margin; offset++) {
+		if (!adi_c2cc_gather_statistics(pri_base, sec_base, trims->p2s_trim + offset, trims->s2p_trim + offset, &p2s_stat, &s2p_stat) ||
+		    (p2s_stat != 0) || (s2p_stat != 0)) {
+			VERBOSE("%s: C2CC stored trims fail at offset %d.\n", __func__, offset);
+			ret = false;
+			break;
+		}
+	}
+
+	/* re-enable bridged interrupts */
+	ADI_C2CC_WRITE_INT_EN(pri_base, 1);
+	ADI_C2CC_WRITE_INT_EN(sec_base, 1);
+
+	return ret;
+}
+
 static bool adi_c2cc_is_all_zero(uint8_t *arr, size_t size)
 {
 	size_t i;
@@ -275,6 +389,20 @@ static bool adi_c2cc_is_all_zero(uint8_t *arr, size_t size)
 	return true;
 }
 
+/* Log the statistics of every trim, eight per line, as a C initializer */
+static void adi_c2cc_log_stats(const char *dir, const uint32_t *stats)
+{
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+	unsigned int i = 0;
+
+	VERBOSE("%s: C2CC %s statistics:\n", __func__, dir);
+	for (i = 0; i < ADI_C2C_TRIM_MAX; i += 8)
+		VERBOSE("\t0x%08x, 0x%08x, 0x%08x, 0x%08x, 0x%08x, 0x%08x, 0x%08x, 0x%08x,\n",
+			stats[i], stats[i + 1], stats[i + 2], stats[i + 3],
+			stats[i + 4], stats[i + 5], stats[i + 6], stats[i + 7]);
+#endif
+}
+
 bool adi_c2cc_analyze_train_data(uint32_t *p2s_stats, uint32_t *s2p_stats, size_t min_size, size_t max_spread, size_t max_center, uint8_t *p2s_trim_delays, uint8_t *s2p_trim_delays, uint8_t *p2s_trim, uint8_t *s2p_trim)
 {
 	size_t eye_width = 0;
@@ -286,6 +414,7 @@ bool adi_c2cc_analyze_train_data(uint32_t *p2s_stats, uint32_t *s2p_stats, size_
 		return false;
 	}
 
+	adi_c2cc_log_stats("p2s", p2s_stats);
 	trim = adi_c2cc_find_optimal_trim(p2s_stats, min_size, max_spread, max_center, trim_delays, &eye_width);
 	if (trim == ADI_C2C_TRIM_MAX && (p2s_trim_delays == NULL || adi_c2cc_is_all_zero(trim_delays, sizeof(trim_delays) / sizeof(trim_delays[0])))) {
 		WARN("%s: C2CC failed to find optimal p2s trim.\n", __func__);
@@ -306,6 +435,7 @@ bool adi_c2cc_analyze_train_data(uint32_t *p2s_stats, uint32_t *s2p_stats, size_
 	if (adi_c2cc_loopback)
 		return true;
 
+	adi_c2cc_log_stats("s2p", s2p_stats);
 	trim = adi_c2cc_find_optimal_trim(s2p_stats, min_size, max_spread, max_center, trim_delays, &eye_width);
 	if (trim == ADI_C2C_TRIM_MAX && (s2p_trim_delays == NULL || adi_c2cc_is_all_zero(trim_delays, sizeof(trim_delays) / sizeof(trim_delays[0])))) {
 		WARN("%s: C2CC failed to find optimal s2p trim.\n", __func__);
@@ -7,6 +7,7 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
 #include <drivers/delay_timer.h>
 #include <drivers/mmc.h>
@@ -19,6 +20,8 @@
 
 /* Macro to denote maximum clock frequency in SDHCI legacy mode */
 #define SDHCI_LEGACY_MODE_MAX_FREQ_HZ         (26U * 1000U * 1000U)
+#define SDHCI_HS_MODE_MAX_FREQ_HZ             (52U * 1000U * 1000U)
+#define SDHCI_HS200_MODE_MAX_FREQ_HZ          (200U * 1000U * 1000U)
 
 /* Macros to denote various timeout values */
 #define SDHCI_CARD_DETECT_TIMEOUT_US_1_MS     (1000U)
@@ -26,6 +29,7 @@
 #define SDHCI_CMD_TIMEOUT_US_100_MS           (100000U)
 #define SDHCI_CLK_STABLE_TIMEOUT_US_150_MS    (150000U)
 #define SDHCI_DATA_XFER_TIMEOUT_US_1_S        (1000000U)
+#define SDHCI_TUNING_BLOCK_TIMEOUT_US_10_MS   (10000U)
 
 /* Standard SDHCI Commands */
 /* eMMC Commands */
@@ -37,6 +41,7 @@
 #define SDHCI_CMD_READ_SINGLE_BLOCK           MMC_CMD(17)
 #define SDHCI_CMD_READ_MULTIPLE_BLOCK         MMC_CMD(18)
 #define SDHCI_CMD_WRITE_SINGLE_BLOCK          MMC_CMD(24)
+#define SDHCI_CMD_SEND_TUNING_BLOCK           MMC_CMD(21)
 #define SDHCI_CMD_WRITE_MULTIPLE_BLOCK        MMC_CMD(25)
 /* SD Commands */
 #define SDHCI_CMD_SEND_SCR                    MMC_ACMD(51)
@@ -52,9 +57,30 @@
 #define SDHCI_DATA_XFER_WRITE                 (0U)
 #define SDHCI_DATA_XFER_READ                  (1U)
 
+/* Tuning blocks sent before the hardware tuning engine gives up */
+#define SDHCI_TUNING_MAX_LOOPS                (40U)
+
+/* Tuning cache word: valid flag, bus width and card clock it was taken at,
+ * and the sampling clock phase found */
+#define SDHCI_TUNING_CACHE_VALID              BIT(31)
+#define SDHCI_TUNING_CACHE_WIDTH_POS          (16U)
+#define SDHCI_TUNING_CACHE_CLK_MHZ_POS        (8U)
+#define SDHCI_TUNING_CACHE_PHASE_BM           GENMASK(7, 0)
+
 /* Host SDMA Buffer Boundary - 512K */
 #define SDHCI_SDMA_BOUNDARY_SIZE              (512U * 1024U)
 
+/* Number of ADMA2 descriptors, each one covering up to 64KB. Requests larger
+ * than the table (or not suitably aligned) fall back to SDMA */
+#ifndef ADI_SDHCI_ADMA2_MAX_DESC
+#define ADI_SDHCI_ADMA2_MAX_DESC              (128U)
+#endif
+
+/* ADMA2 descriptor size in 32-bit words: 64-bit format for 32-bit addressing,
+ * 128-bit format for 64-bit addressing in Host Version 4 mode */
+#define ADMA2_DESC_WORDS_32BIT_ADDR           (2U)
+#define ADMA2_DESC_WORDS_64BIT_ADDR           (4U)
+
 /****************** Internal Function Prototypes ******************/
 static bool adi_sdhci_use_dma_for_data_xfer(void);
 static enum mmc_device_type adi_sdhci_get_dev_type(void);
@@ -64,9 +90,14 @@ static int adi_sdhci_control_card_clk(const uint8_t clk_ctl);
 static int adi_sdhci_change_clk_freq(const uint32_t clk_freq_hz);
 static int adi_sdhci_sw_reset(const uint8_t mask);
 static int adi_sdhci_set_bus_width(const unsigned int width);
+static uint32_t adi_sdhci_tuning_cache_key(void);
+static void adi_sdhci_update_tuning_cache(uint32_t cache);
+static void adi_sdhci_set_sample_phase(uint32_t phase);
+static int adi_sdhci_send_tuning_block(void);
 static void adi_sdhci_initialize_host_controller(void);
 static int adi_sdhci_non_dma_xfer(int lba, uintptr_t buf, const size_t size, const bool dir);
 static int adi_sdhci_dma_xfer(uintptr_t buf);
+static bool adi_sdhci_adma2_setup(uintptr_t buf, size_t size);
 static int adi_sdhci_handle_bus_errors(void);
 
 /***************** External Function Prototypes ******************/
@@ -76,6 +107,8 @@ static int adi_sdhci_set_ios(unsigned int clk, unsigned int width);
 static int adi_sdhci_prepare(int lba, uintptr_t buf, size_t size);
 static int adi_sdhci_read(int lba, uintptr_t buf, size_t size);
 static int adi_sdhci_write(int lba, uintptr_t buf, size_t size);
+static int adi_sdhci_set_timing(unsigned int timing);
+static int adi_sdhci_execute_tuning(void);
 
 /*********************** Global Variables *************************/
 static const struct mmc_ops adi_sdhci_ops = {
@@ -85,6 +118,8 @@ static const struct mmc_ops adi_sdhci_ops = {
 	.prepare	= adi_sdhci_prepare,
 	.read		= adi_sdhci_read,
 	.write		= adi_sdhci_write,
+	.set_timing	= adi_sdhci_set_timing,
+	.execute_tuning = adi_sdhci_execute_tuning,
 };
 
 static struct adi_mmc_params adi_sdhci_params;
@@ -95,6 +130,18 @@ static bool card_initialized = false;
 
 static bool use_dma_mode = false;
 
+/* Current bus timing (MMC_TIMING_*) */
+static unsigned int sdhci_timing = MMC_TIMING_LEGACY;
+
+/* Whether the data transfer being prepared uses ADMA2 (true) or SDMA */
+static bool use_adma2_xfer = false;
+
+static uint32_t adma2_desc_table[ADI_SDHCI_ADMA2_MAX_DESC * ADMA2_DESC_WORDS_64BIT_ADDR] __aligned(8);
+
+/* Read throughput statistics */
+static uint64_t read_bytes;
+static uint64_t read_ticks;
+
 static struct mmc_device_info sdhci_dev_info;
 
 /****************** Internal Function Definitions ******************/
@@ -264,11 +311,19 @@ static int adi_sdhci_change_clk_freq(const uint32_t clk_freq_hz)
 {
 	uintptr_t base = adi_sdhci_params.reg_base;
 	uint64_t timeout;
+	uint32_t max_freq_hz;
 	uint32_t divisor;
 	uint16_t u16_reg_data;
 	int err;
 
-	if ((clk_freq_hz > SDHCI_LEGACY_MODE_MAX_FREQ_HZ) ||
+	if (sdhci_timing >= MMC_TIMING_HS200)
+		max_freq_hz = SDHCI_HS200_MODE_MAX_FREQ_HZ;
+	else if (sdhci_timing == MMC_TIMING_HS)
+		max_freq_hz = SDHCI_HS_MODE_MAX_FREQ_HZ;
+	else
+		max_freq_hz = SDHCI_LEGACY_MODE_MAX_FREQ_HZ;
+
+	if ((clk_freq_hz > max_freq_hz) ||
 	    (0U == adi_sdhci_params.src_clk_hz))
 		return -EINVAL;
 
@@ -389,6 +444,91 @@ static int adi_sdhci_set_bus_width(const unsigned int width)
 	return err;
 }
 
+static uint32_t adi_sdhci_tuning_cache_key(void)
+{
+	return SDHCI_TUNING_CACHE_VALID |
+	       (adi_sdhci_params.bus_width << SDHCI_TUNING_CACHE_WIDTH_POS) |
+	       ((adi_sdhci_params.hs_clk_rate / 1000000U) << SDHCI_TUNING_CACHE_CLK_MHZ_POS);
+}
+
+static void adi_sdhci_update_tuning_cache(uint32_t cache)
+{
+	if (adi_sdhci_params.tuning_cache == cache)
+		return;
+
+	adi_sdhci_params.tuning_cache = cache;
+	if (adi_sdhci_params.save_tuning_cache != NULL)
+		adi_sdhci_params.save_tuning_cache(cache);
+}
+
+/* Program a known sampling clock phase, bypassing the tuning engine */
+static void adi_sdhci_set_sample_phase(uint32_t phase)
+{
+	uintptr_t base = adi_sdhci_params.reg_base;
+	uint32_t u32_reg_data;
+	uint16_t u16_reg_data;
+
+	(void)adi_sdhci_control_card_clk(SDHCI_STOP_CARD_CLK);
+
+	mmio_setbits_32(base + SDHCI_AT_CTRL_R_OFF, SW_TUNE_EN_BM);
+	u32_reg_data = (mmio_read_32(base + SDHCI_AT_STAT_R_OFF) & ~CENTER_PH_CODE_BM);
+	u32_reg_data |= (phase & CENTER_PH_CODE_BM);
+	mmio_write_32(base + SDHCI_AT_STAT_R_OFF, u32_reg_data);
+
+	/* Sample with the tuned clock */
+	u16_reg_data = (mmio_read_16(base + SDHCI_HOST_CTRL2_R_OFF) | SAMPLE_CLK_SEL_BM);
+	mmio_write_16(base + SDHCI_HOST_CTRL2_R_OFF, u16_reg_data);
+
+	(void)adi_sdhci_control_card_clk(SDHCI_SUPPLY_CARD_CLK);
+}
+
+/* Issue CMD21 and wait for the tuning block to be received */
+static int adi_sdhci_send_tuning_block(void)
+{
+	uintptr_t base = adi_sdhci_params.reg_base;
+	uint64_t timeout;
+	uint16_t block_size;
+	uint32_t cmd_r_flags;
+	volatile uint16_t normal_int_stat;
+
+	timeout = timeout_init_us(SDHCI_CMD_TIMEOUT_US_100_MS);
+	while (mmio_read_32(base + SDHCI_PSTATE_REG_R_OFF) & (CMD_INHIBIT_BM | CMD_INHIBIT_DAT_BM)) {
+		if (timeout_elapsed(timeout))
+			return -ETIMEDOUT;
+	}
+
+	/* Tuning block is 128 bytes on an 8-bit bus, 64 bytes on a 4-bit bus */
+	if (mmio_read_8(base + SDHCI_HOST_CTRL1_R_OFF) & EXT_DAT_XFER_BM)
+		block_size = 128U;
+	else
+		block_size = 64U;
+
+	mmio_write_16(base + SDHCI_BLOCK_SIZE_R_OFF, block_size);
+	mmio_write_16(base + SDHCI_BLOCK_COUNT_R_OFF, 0x00U);
+	mmio_write_32(base + SDHCI_32BIT_BLK_CNT_R_OFF, 1U);
+
+	mmio_write_16(base + SDHCI_NORMAL_INT_STAT_R_OFF, NORMAL_INT_STAT_MASK);
+	mmio_write_16(base + SDHCI_ERROR_INT_STAT_R_OFF, ERROR_INT_STAT_MASK);
+
+	cmd_r_flags = (SDHCI_CMD_RESP_SHORT | CMD_CRC_CHK_ENABLE_BM |
+		       CMD_IDX_CHK_ENABLE_BM | DATA_PRESENT_SEL_BM);
+	mmio_write_32(base + SDHCI_ARGUMENT_R_OFF, 0U);
+	mmio_write_16(base + SDHCI_XFER_MODE_R_OFF, DATA_XFER_DIR_BM);
+	mmio_write_16(base + SDHCI_CMD_R_OFF, SDHCI_MAKE_CMD(SDHCI_CMD_SEND_TUNING_BLOCK, cmd_r_flags));
+
+	/* The controller consumes the block itself, only wait for Buffer Read Ready */
+	timeout = timeout_init_us(SDHCI_TUNING_BLOCK_TIMEOUT_US_10_MS);
+	do {
+		normal_int_stat = mmio_read_16(base + SDHCI_NORMAL_INT_STAT_R_OFF);
+		if (timeout_elapsed(timeout))
+			return -ETIMEDOUT;
+	} while (0U == (normal_int_stat & BUF_RD_READY_STAT_EN_BM));
+
+	mmio_write_16(base + SDHCI_NORMAL_INT_STAT_R_OFF, NORMAL_INT_STAT_MASK);
+
+	return 0;
+}
+
 static void adi_sdhci_initialize_host_controller(void)
 {
 	uintptr_t base = adi_sdhci_params.reg_base;
@@ -586,7 +726,8 @@ static int adi_sdhci_dma_xfer(uintptr_t buf)
 		if (normal_int_stat & ERR_INTERRUPT_BM)
 			return adi_sdhci_handle_bus_errors();
 
-		if (normal_int_stat & DMA_INTERRUPT_BM) {
+		/* ADMA2 walks the whole descriptor table without boundary interrupts */
+		if ((normal_int_stat & DMA_INTERRUPT_BM) && !use_adma2_xfer) {
 			/* Clear the DMA interrupt status */
 			mmio_write_16(base + SDHCI_NORMAL_INT_STAT_R_OFF, DMA_INTERRUPT_BM);
 			/* Update the buffer address in System Address register for SDMA */
@@ -612,6 +753,54 @@ static int adi_sdhci_dma_xfer(uintptr_t buf)
 	return 0;
 }
 
+/* Build an ADMA2 descriptor table covering the whole buffer.
+ * Returns false if the request can't be described, so SDMA must be used */
+static bool adi_sdhci_adma2_setup(uintptr_t buf, size_t size)
+{
+	uintptr_t base = adi_sdhci_params.reg_base;
+	uint32_t desc_words;
+	uint32_t ndesc;
+	uint32_t len;
+	uint32_t attr;
+	uint32_t i;
+
+	if (mmio_read_16(base + SDHCI_HOST_CTRL2_R_OFF) & ADDRESSING_BM)
+		desc_words = ADMA2_DESC_WORDS_64BIT_ADDR;
+	else
+		desc_words = ADMA2_DESC_WORDS_32BIT_ADDR;
+
+	/* Data address must be aligned to the descriptor address size */
+	ndesc = (size + ADMA2_DESC_MAX_LEN - 1U) / ADMA2_DESC_MAX_LEN;
+	if ((ndesc > ADI_SDHCI_ADMA2_MAX_DESC) || ((buf % (desc_words * 2U)) != 0U))
+		return false;
+
+	for (i = 0U; i < ndesc; i++) {
+		len = MIN(size, (size_t)ADMA2_DESC_MAX_LEN);
+		attr = ADMA2_ATTR_VALID | ADMA2_ATTR_ACT_TRAN;
+		if (i == (ndesc - 1U))
+			attr |= ADMA2_ATTR_END;
+
+		/* A length field of 0 means 64KB */
+		adma2_desc_table[(i * desc_words) + 0U] = attr | ((len & 0xFFFFU) << 16U);
+		adma2_desc_table[(i * desc_words) + 1U] = (uint32_t)buf;
+		if (desc_words == ADMA2_DESC_WORDS_64BIT_ADDR) {
+			adma2_desc_table[(i * desc_words) + 2U] = (uint32_t)((uint64_t)buf >> 32U);
+			adma2_desc_table[(i * desc_words) + 3U] = 0U;
+		}
+
+		buf += len;
+		size -= len;
+	}
+
+	/* Make the table visible to the DMA engine */
+	flush_dcache_range((uintptr_t)adma2_desc_table, ndesc * desc_words * sizeof(uint32_t));
+
+	mmio_write_32(base + SDHCI_ADMA_SA_LOW_R_OFF, (uint32_t)(uintptr_t)adma2_desc_table);
+	mmio_write_32(base + SDHCI_ADMA_SA_HIGH_R_OFF, (uint32_t)((uint64_t)(uintptr_t)adma2_desc_table >> 32U));
+
+	return true;
+}
+
 static int adi_sdhci_handle_bus_errors(void)
 {
 	uintptr_t base = adi_sdhci_params.reg_base;
@@ -635,6 +824,11 @@ static int adi_sdhci_handle_bus_errors(void)
 			return ret;
 	}
 
+	/* A cached sampling phase that produces data CRC errors is stale,
+	 * drop it so the next boot tunes again */
+	if ((err_int_stat & DATA_CRC_ERR_STAT_EN_BM) && (sdhci_timing >= MMC_TIMING_HS200))
+		adi_sdhci_update_tuning_cache(0U);
+
 	/* Reset DAT line on occurrance of data line error */
 	if (err_int_stat & DATA_LINE_ERR_INTR_BM) {
 		ret = adi_sdhci_sw_reset(SW_RST_DAT_BM);
@@ -682,6 +876,9 @@ static void adi_sdhci_init(void)
 	/* Use non-dma mode for initialization */
 	use_dma_mode = false;
 
+	/* Start from legacy timing, mmc.c negotiates faster ones */
+	sdhci_timing = MMC_TIMING_LEGACY;
+
 	/* Reset the Host Controller */
 	(void)adi_sdhci_sw_reset(SW_RST_ALL_BM);
 
@@ -808,9 +1005,14 @@ static int adi_sdhci_send_cmd(struct mmc_cmd *cmd)
 	if (adi_sdhci_is_data_xfr_cmd(cmd->cmd_idx)) {
 		/* Enable Block Count and Block Select for Multiple block transfers */
 		if ((SDHCI_CMD_READ_MULTIPLE_BLOCK == cmd->cmd_idx) ||
-		    (SDHCI_CMD_WRITE_MULTIPLE_BLOCK == cmd->cmd_idx))
+		    (SDHCI_CMD_WRITE_MULTIPLE_BLOCK == cmd->cmd_idx)) {
 			xfer_mode = (MULTI_BLK_SEL_BM | BLOCK_COUNT_ENABLE_BM);
 
+			/* Let the controller send CMD23 with the 32-bit block count */
+			if (adi_sdhci_params.flags & MMC_FLAG_AUTO_CMD23)
+				xfer_mode |= (AUTO_CMD23_ENABLED << AUTO_CMD_ENABLE_POS);
+		}
+
 		/* Set the data transfer direction.
 		 * 0 - Write
 		 * 1 - Read */
@@ -941,6 +1143,12 @@ static int adi_sdhci_set_ios(unsigned int clk, unsigned int width)
 {
 	int ret;
 
+	/* HS200/HS400 run at the platform high speed card clock */
+	if (sdhci_timing >= MMC_TIMING_HS200)
+		clk = adi_sdhci_params.hs_clk_rate;
+	else if (sdhci_timing == MMC_TIMING_HS)
+		clk = MIN(clk, SDHCI_HS_MODE_MAX_FREQ_HZ);
+
 	/* Configure data bus width */
 	ret = adi_sdhci_set_bus_width(width);
 	if (ret != 0)
@@ -950,6 +1158,111 @@ static int adi_sdhci_set_ios(unsigned int clk, unsigned int width)
 	return adi_sdhci_change_clk_freq(clk);
 }
 
+static int adi_sdhci_set_timing(unsigned int timing)
+{
+	uintptr_t base = adi_sdhci_params.reg_base;
+	uint16_t u16_reg_data;
+	uint16_t uhs_mode;
+	uint8_t u8_reg_data;
+	int err;
+
+	switch (timing) {
+	case MMC_TIMING_LEGACY:
+		uhs_mode = UHS_MODE_SEL_LEGACY;
+		break;
+	case MMC_TIMING_HS:
+		uhs_mode = UHS_MODE_SEL_HS_SDR;
+		break;
+	case MMC_TIMING_HS200:
+		uhs_mode = UHS_MODE_SEL_HS200;
+		break;
+	case MMC_TIMING_HS400:
+		uhs_mode = UHS_MODE_SEL_HS400;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if ((timing >= MMC_TIMING_HS200) && (0U == adi_sdhci_params.hs_clk_rate))
+		return -EOPNOTSUPP;
+
+	/* Card clock must be stopped while the bus speed mode changes,
+	 * set_ios() restarts it at the new frequency */
+	err = adi_sdhci_control_card_clk(SDHCI_STOP_CARD_CLK);
+	if (err != 0)
+		return err;
+
+	u8_reg_data = mmio_read_8(base + SDHCI_HOST_CTRL1_R_OFF);
+	if (timing == MMC_TIMING_LEGACY)
+		u8_reg_data &= ~HIGH_SPEED_EN_BM;
+	else
+		u8_reg_data |= HIGH_SPEED_EN_BM;
+	mmio_write_8(base + SDHCI_HOST_CTRL1_R_OFF, u8_reg_data);
+
+	u16_reg_data = (mmio_read_16(base + SDHCI_HOST_CTRL2_R_OFF) & ~UHS_MODE_SEL_BM);
+	u16_reg_data |= uhs_mode;
+	mmio_write_16(base + SDHCI_HOST_CTRL2_R_OFF, u16_reg_data);
+
+	sdhci_timing = timing;
+
+	VERBOSE("%s: timing=%u\n", __func__, timing);
+
+	return 0;
+}
+
+static int adi_sdhci_execute_tuning(void)
+{
+	uintptr_t base = adi_sdhci_params.reg_base;
+	uint32_t key = adi_sdhci_tuning_cache_key();
+	uint32_t phase;
+	uint16_t u16_reg_data;
+	unsigned int i;
+	int err = 0;
+
+	/* Reuse the phase found on a previous boot at the same clock and width */
+	if ((adi_sdhci_params.tuning_cache & ~SDHCI_TUNING_CACHE_PHASE_BM) == key) {
+		phase = adi_sdhci_params.tuning_cache & SDHCI_TUNING_CACHE_PHASE_BM;
+		adi_sdhci_set_sample_phase(phase);
+		INFO("eMMC: using cached tuning phase %u\n", phase);
+		return 0;
+	}
+
+	/* Use the hardware tuning engine */
+	mmio_clrbits_32(base + SDHCI_AT_CTRL_R_OFF, SW_TUNE_EN_BM);
+	u16_reg_data = (mmio_read_16(base + SDHCI_HOST_CTRL2_R_OFF) & ~SAMPLE_CLK_SEL_BM);
+	u16_reg_data |= EXEC_TUNING_BM;
+	mmio_write_16(base + SDHCI_HOST_CTRL2_R_OFF, u16_reg_data);
+
+	for (i = 0U; i < SDHCI_TUNING_MAX_LOOPS; i++) {
+		err = adi_sdhci_send_tuning_block();
+		if (err != 0)
+			break;
+		if (0U == (mmio_read_16(base + SDHCI_HOST_CTRL2_R_OFF) & EXEC_TUNING_BM))
+			break;
+	}
+
+	u16_reg_data = mmio_read_16(base + SDHCI_HOST_CTRL2_R_OFF);
+	if ((err == 0) && ((u16_reg_data & (EXEC_TUNING_BM | SAMPLE_CLK_SEL_BM)) != SAMPLE_CLK_SEL_BM))
+		err = -EIO;
+
+	if (err != 0) {
+		ERROR("%s: Tuning failed (%d).\n", __func__, err);
+		u16_reg_data &= ~(EXEC_TUNING_BM | SAMPLE_CLK_SEL_BM);
+		mmio_write_16(base + SDHCI_HOST_CTRL2_R_OFF, u16_reg_data);
+		(void)adi_sdhci_sw_reset(SW_RST_CMD_BM);
+		(void)adi_sdhci_sw_reset(SW_RST_DAT_BM);
+		adi_sdhci_update_tuning_cache(0U);
+		return err;
+	}
+
+	phase = mmio_read_32(base + SDHCI_AT_STAT_R_OFF) & CENTER_PH_CODE_BM;
+	adi_sdhci_update_tuning_cache(key | phase);
+
+	INFO("eMMC: tuning done after %u blocks, phase %u\n", i + 1U, phase);
+
+	return 0;
+}
+
 static int adi_sdhci_prepare(int lba, uintptr_t buf, size_t size)
 {
 	uintptr_t base = adi_sdhci_params.reg_base;
@@ -975,11 +1288,16 @@ static int adi_sdhci_prepare(int lba, uintptr_t buf, size_t size)
 	if (use_dma)
 		flush_dcache_range(buf, size);
 
+	/* Prefer ADMA2, which covers the whole request without boundary stalls */
+	use_adma2_xfer = use_dma && adi_sdhci_adma2_setup(buf, size);
+
 	/***** Prepare the Host Controller for data transfer *****/
 	/* Clear the DMA_SEL bits in HOST_CTRL1_R */
 	u8_reg_data = (mmio_read_8(base + SDHCI_HOST_CTRL1_R_OFF) & ~DMA_SEL_BM);
-	/* Enable SDMA Selection */
-	if (use_dma)
+	/* Enable ADMA2 or SDMA Selection */
+	if (use_adma2_xfer)
+		u8_reg_data |= (DMA_SEL_ADMA2 << DMA_SEL_POS);
+	else if (use_dma)
 		u8_reg_data |= (DMA_SEL_SDMA << DMA_SEL_POS);
 	mmio_write_8(base + SDHCI_HOST_CTRL1_R_OFF, u8_reg_data);
 
@@ -992,7 +1310,7 @@ static int adi_sdhci_prepare(int lba, uintptr_t buf, size_t size)
 	u16_reg_data |= block_size;
 	/* Configure SDMA Buffer Boundary. Set maximum value of 512K as the size of
 	 * contiguous buffer in system memory to avoid frequent DMA interrupts */
-	if (use_dma) {
+	if (use_dma && !use_adma2_xfer) {
 		u16_reg_data &= ~SDMA_BUF_BDARY_BM;
 		u16_reg_data |= (SDMA_BUF_BDARY_512K << SDMA_BUF_BDARY_POS);
 	}
@@ -1003,8 +1321,8 @@ static int adi_sdhci_prepare(int lba, uintptr_t buf, size_t size)
 	mmio_write_16(base + SDHCI_BLOCK_COUNT_R_OFF, 0x00U);
 	mmio_write_32(base + SDHCI_32BIT_BLK_CNT_R_OFF, block_cnt);
 
-	/* Set data location of the system memory */
-	if (use_dma)
+	/* Set data location of the system memory (ADMA2 uses the descriptor table instead) */
+	if (use_dma && !use_adma2_xfer)
 		mmio_write_32(base + SDHCI_ADMA_SA_LOW_R_OFF, (uint32_t)buf);
 
 	return 0;
@@ -1012,6 +1330,7 @@ static int adi_sdhci_prepare(int lba, uintptr_t buf, size_t size)
 
 static int adi_sdhci_read(int lba, uintptr_t buf, size_t size)
 {
+	uint64_t start = read_cntpct_el0();
 	int ret;
 
 	if (adi_sdhci_use_dma_for_data_xfer()) {
@@ -1023,6 +1342,11 @@ static int adi_sdhci_read(int lba, uintptr_t buf, size_t size)
 		ret = adi_sdhci_non_dma_xfer(lba, buf, size, SDHCI_DATA_XFER_READ);
 	}
 
+	if (ret == 0) {
+		read_ticks += read_cntpct_el0() - start;
+		read_bytes += size;
+	}
+
 	return ret;
 }
 
@@ -1061,6 +1385,14 @@ int adi_mmc_init(struct adi_mmc_params *params)
 		adi_sdhci_params.flags |= MMC_FLAG_CMD23;
 	}
 
+	/* The card clock can't run faster than its source */
+	if (adi_sdhci_params.hs_clk_rate > adi_sdhci_params.src_clk_hz)
+		adi_sdhci_params.hs_clk_rate = adi_sdhci_params.src_clk_hz;
+
+	/* HS200/HS400 need a high speed card clock */
+	if (0U == adi_sdhci_params.hs_clk_rate)
+		adi_sdhci_params.flags &= ~(MMC_FLAG_HS200 | MMC_FLAG_HS400);
+
 	ret = mmc_init(&adi_sdhci_ops, adi_sdhci_params.clk_rate,
 		       adi_sdhci_params.bus_width, adi_sdhci_params.flags,
 		       adi_sdhci_params.device_info);
@@ -1072,6 +1404,12 @@ int adi_mmc_init(struct adi_mmc_params *params)
 	return ret;
 }
 
+void adi_mmc_get_read_stats(uint64_t *bytes, uint64_t *ticks)
+{
+	*bytes = read_bytes;
+	*ticks = read_ticks;
+}
+
 int adi_mmc_deinit(uintptr_t reg_base)
 {
 	adi_sdhci_params.reg_base = reg_base;
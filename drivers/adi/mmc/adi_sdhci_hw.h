@@ -34,8 +34,10 @@
 #define SDHCI_HOST_CTRL2_R_OFF             (0x3EU)
 #define SDHCI_CAPABILITIES1_R_OFF          (0x40U)
 #define SDHCI_ADMA_SA_LOW_R_OFF            (0x58U)
+#define SDHCI_ADMA_SA_HIGH_R_OFF           (0x5CU)
 #define SDHCI_EMMC_CTRL_R_OFF              (0x52CU)
 #define SDHCI_AT_CTRL_R_OFF                (0x540U)
+#define SDHCI_AT_STAT_R_OFF                (0x544U)
 
 /* Bit mask */
 /* BLOCKSIZE_R */
@@ -62,6 +64,7 @@
 #define CARD_INSERTED_BM                   BIT(16)
 /* HOST_CTRL1_R */
 #define DAT_XFER_WIDTH_BM                  BIT(1)
+#define HIGH_SPEED_EN_BM                   BIT(2)
 #define DMA_SEL_BM                         GENMASK(4, 3)
 #define EXT_DAT_XFER_BM                    BIT(5)
 /* PWR_CTRL_R */
@@ -106,6 +109,8 @@
 /* HOST_CTRL2_R */
 #define UHS_MODE_SEL_BM                    GENMASK(2, 0)
 #define SIGNALING_EN                       BIT(3)
+#define EXEC_TUNING_BM                     BIT(6)
+#define SAMPLE_CLK_SEL_BM                  BIT(7)
 #define UHS2_IF_ENABLE_BM                  BIT(8)
 #define HOST_VER4_ENABLE_BM                BIT(12)
 #define ADDRESSING_BM                      BIT(13)
@@ -117,6 +122,10 @@
 #define ASYNC_INT_SUPPORT_BM               BIT(29)
 /* EMMC_CTRL_R */
 #define CARD_IS_EMMC_BM                    BIT(0)
+/* AT_CTRL_R */
+#define SW_TUNE_EN_BM                      BIT(4)
+/* AT_STAT_R */
+#define CENTER_PH_CODE_BM                  GENMASK(7, 0)
 
 /* Bit field values */
 #define SD_BUS_VOL_VDD1_1V8                (0x0000000AU)
@@ -135,6 +144,7 @@
 #define FREQ_SEL_POS                       (8U)
 #define UPPER_FREQ_SEL_POS                 (6U)
 #define CMD_TYPE_POS                       (6U)
+#define AUTO_CMD_ENABLE_POS                (2U)
 #define DMA_SEL_POS                        (3U)
 #define SDMA_BUF_BDARY_POS                 (12U)
 /* - AT_CTRL_R */
@@ -169,5 +179,25 @@
 #define DMA_SEL_ADMA2                      (0x02U)
 #define DMA_SEL_ADMA2_OR_ADMA3             (0x03U)
 
+/* UHS_MODE_SEL values in HOST_CTRL2_R register (eMMC) */
+#define UHS_MODE_SEL_LEGACY                (0x00U)
+#define UHS_MODE_SEL_HS_SDR                (0x01U)
+#define UHS_MODE_SEL_HS200                 (0x03U)
+#define UHS_MODE_SEL_HS400                 (0x07U)
+
 /* SDMA Buffer Boundary value */
 #define SDMA_BUF_BDARY_512K                (7U)
+
+/* AUTO_CMD_ENABLE values in XFER_MODE_R register */
+#define AUTO_CMD_DISABLED                  (0x00U)
+#define AUTO_CMD12_ENABLED                 (0x01U)
+#define AUTO_CMD23_ENABLED                 (0x02U)
+
+/* ADMA2 descriptor attribute bits */
+#define ADMA2_ATTR_VALID                   BIT(0)
+#define ADMA2_ATTR_END                     BIT(1)
+#define ADMA2_ATTR_INT                     BIT(2)
+#define ADMA2_ATTR_ACT_TRAN                (0x20U)
+
+/* ADMA2 maximum data length per descriptor (16-bit length mode, 0 means 64KB) */
+#define ADMA2_DESC_MAX_LEN                 (0x10000U)
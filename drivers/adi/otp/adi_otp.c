@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <string.h>
 #include <drivers/delay_timer.h>
 #include <drivers/adi/adi_otp.h>
 #include <lib/mmio.h>
@@ -84,6 +85,17 @@ static uint32_t RQ_CQ_PMC_PROG_2 = DEFAULT_RQ_CQ_PMC_PROG_2;
 static uint32_t RQ_CQ_PMC_PROG_1 = DEFAULT_RQ_CQ_PMC_PROG_1;
 static uint32_t RQ_CQ_PMC_PROG_0 = DEFAULT_RQ_CQ_PMC_PROG_0;
 
+/* SRAM copy of an OTP range, see otp_shadow_init() */
+static struct {
+	uintptr_t base;
+	uintptr_t addr;
+	uint32_t *data;
+	size_t len;
+	uint8_t ecc_state;
+	bool valid;
+} shadow;
+static uint32_t shadow_hits;
+
 /*--------------------------------------------------------
  * INTERNAL FUNCTIONS PROTOTYPES
  *------------------------------------------------------*/
@@ -103,6 +115,8 @@ static int program_without_ECC_done(const uintptr_t base);
 
 static int op_disable_interface(const uintptr_t base);
 
+static bool shadow_read(const uintptr_t base, const uintptr_t addr, uint32_t *buffer, size_t len, uint8_t ecc_state);
+
 /*
  *  NOTE:
  *  The following operation functions implement the operations sequences stated in the "ADI OPT RD WR Operation Sequence.xlsx",
@@ -220,6 +234,19 @@ static int program_without_ECC_done(const uintptr_t base)
 	return (READ_MEM_CTRL_REGMAP_MC_CMD_PGM_STATUS_0(base) & PGM_WITHOUT_ECC_STATUS_MASK) >> PGM_WITHOUT_ECC_STATUS_BITP == PGM_WITHOUT_ECC_STATUS_OK;
 }
 
+/* Serve a read from the shadow copy if it fully covers it */
+static bool shadow_read(const uintptr_t base, const uintptr_t addr, uint32_t *buffer, size_t len, uint8_t ecc_state)
+{
+	if (!shadow.valid || (base != shadow.base) || (ecc_state != shadow.ecc_state) ||
+	    (addr < shadow.addr) || ((addr + len) > (shadow.addr + shadow.len)))
+		return false;
+
+	memcpy(buffer, &shadow.data[addr - shadow.addr], len * sizeof(uint32_t));
+	shadow_hits += len;
+
+	return true;
+}
+
 static int op_disable_interface(const uintptr_t base)
 {
 	/* Disable */
@@ -487,6 +514,9 @@ int otp_read(const uintptr_t base, const uintptr_t addr, uint32_t *value, uint8_
 {
 	int ret = ADI_OTP_SUCCESS;
 
+	if (shadow_read(base, addr, value, 1, ecc_state))
+		return ADI_OTP_SUCCESS;
+
 	ret = op_read_setup(base, ecc_state);
 	if (ret != ADI_OTP_SUCCESS) return ret;
 
@@ -501,6 +531,9 @@ int otp_read_burst(const uintptr_t base, const uintptr_t addr, uint32_t *buffer,
 	int ret = ADI_OTP_SUCCESS;
 	size_t i;
 
+	if (shadow_read(base, addr, buffer, len, ecc_state))
+		return ADI_OTP_SUCCESS;
+
 	ret = op_read_setup(base, ecc_state);
 	if (ret != ADI_OTP_SUCCESS) return ret;
 
@@ -520,6 +553,9 @@ int otp_write_burst(const uintptr_t base, const uintptr_t addr, const uint32_t *
 	int ret = ADI_OTP_SUCCESS;
 	size_t i;
 
+	/* Drop the shadow copy before programming, a failed write may leave any word changed */
+	shadow.valid = false;
+
 	ret = op_program_setup(base, ecc_state);
 	if (ret != ADI_OTP_SUCCESS) return ret;
 
@@ -535,3 +571,29 @@ int otp_write(const uintptr_t base, const uintptr_t addr, uint32_t data, uint8_t
 {
 	return otp_write_burst(base, addr, &data, 1, ecc_state);
 }
+
+int otp_shadow_init(const uintptr_t base, const uintptr_t addr, uint32_t *buffer, size_t len, uint8_t ecc_state)
+{
+	int ret;
+
+	shadow.valid = false;
+	shadow_hits = 0;
+
+	/* One read setup for the whole range, then the words are read back to back */
+	ret = otp_read_burst(base, addr, buffer, len, ecc_state);
+	if (ret != ADI_OTP_SUCCESS) return ret;
+
+	shadow.base = base;
+	shadow.addr = addr;
+	shadow.data = buffer;
+	shadow.len = len;
+	shadow.ecc_state = ecc_state;
+	shadow.valid = true;
+
+	return ADI_OTP_SUCCESS;
+}
+
+uint32_t otp_shadow_get_hits(void)
+{
+	return shadow_hits;
+}
@@ -6,6 +6,9 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#ifndef ADI_TE_PLAT
+#include <arch_helpers.h>
+#endif
 #include <drivers/delay_timer.h>
 #include <drivers/spi_mem.h>
 #include <drivers/adi/adi_qspi.h>
@@ -21,16 +24,25 @@
  * Every transaction is composed of several individual transfers (adi_qspi_xfer):
  *     cmd + addr (3/4 bytes) + dummy cycles + data (read/write)
  * which take care of the HW transfer length limit (64 KB) by spliting the
- * transfer (if applicable).in several blocks.
+ * transfer (if applicable).in several blocks. When cmd, addr and dummy use
+ * the same bus width they are packed and sent as one TX FIFO burst, and data
+ * phases shorter than QSPI_DMA_MIN_LEN skip the DMA setup.
  * Finally, there are two primitives (adi_qspi_tx_xfer, adi_qspi_rx_xfer)
  * intended to send or receive data.
  *
+ * DMA reads larger than one block are pipelined (adi_qspi_rx_xfer_2d): the
+ * DDE is programmed once in 2-D mode (one row per block) and the SPI receive
+ * word count is re-armed with the exact block length as soon as the previous
+ * block has been received, so there is no per-block DDE setup or cache
+ * maintenance.
+ *
  * Driver characteristics:
  *
  * - Support all SPI protocols (standard SPI, Extended, Dual and Quad)
  * - Chip select managed by FW
  * - Support DMA (DDE)
  * - Poll based design (blocking calls)
+ * - Status register polling with a single command (poll_status)
  * - SPI word transfer size is always 8-bit
  * - DMA transfer width as large as possible
  *
@@ -46,6 +58,8 @@
 #define SPI_BUSWIDTH_2_LINE         2U                  /* 2 Data Lines Buswidth */
 #define SPI_BUSWIDTH_4_LINE         4U                  /* 4 Data Lines Buswidth */
 #define DEVICE_ADDR_MAX_BYTES       4U                  /* Device address is 3 or 4 bytes */
+#define QSPI_HEADER_MAX_BYTES       16U                 /* Opcode + address + dummy bytes sent in one burst */
+#define QSPI_DMA_MIN_LEN            64U                 /* Shorter transfers use PIO, DMA setup would dominate */
 #define SPI_MIN_FREQ                100000U             /* SPI min freq: 100 KHz
 	                                                 * This safe limit is based on the TE timer capability to measure the required
 	                                                 * timeout interval for the worst case scenario (64KB transfer) */
@@ -72,6 +86,12 @@
 
 static struct adi_qspi_ctrl adi_qspi_params;
 
+#ifndef ADI_TE_PLAT
+/* Data phase read statistics, used to report the achieved throughput */
+static uint64_t adi_qspi_rx_bytes;
+static uint64_t adi_qspi_rx_ticks;
+#endif
+
 static uintptr_t qspi_base(void)
 {
 	return adi_qspi_params.reg_base;
@@ -360,12 +380,96 @@ rx_transfer_end:
 	return ret;
 }
 
+/* Receive nblocks consecutive blocks of block_len bytes with a single DDE 2-D transfer */
+static int adi_qspi_rx_xfer_2d(uint8_t *buf, uint32_t block_len, uint32_t nblocks)
+{
+	int ret = 0;
+	uint64_t timeout;
+	uint32_t dde_addr = (uintptr_t)buf;
+	uint32_t ycnt;
+	uint32_t prev_ycnt;
+	uint32_t armed;
+	uint32_t cfg;
+	uint8_t psize;
+	uint8_t msize = 0;
+	uint8_t dummy_buf;
+
+	/*  Clean status and rx_ctl */
+	mmio_write_32(qspi_base() + SPI_RXCTL, 0);
+	mmio_write_32(qspi_base() + SPI_STAT, 0xFFFFFFFF);
+
+	/* Clean RFIFO (although it should be empty) */
+	while (!(mmio_read_32(qspi_base() + SPI_STAT) & SPI_STAT_RFE))
+		adi_qspi_read_fifo(&dummy_buf, qspi_base() + SPI_RFIFO);
+
+	/* Set bytes to receive for the first block. No reload, each block is
+	 * armed with its exact length so the SPI never runs past the last one */
+	mmio_write_32(qspi_base() + SPI_RWC, block_len);
+	mmio_write_32(qspi_base() + SPI_RWCR, 0);
+
+	/* Get PSIZE/MSIZE (block_len is a multiple of 32 bytes) */
+	adi_qspi_get_buses_size(dde_addr, block_len, &psize, &msize);
+
+	/* Invalidate cache for the whole range once before using DMA */
+	inv_dcache_range(dde_addr, (size_t)block_len * nblocks);
+
+	/* Configure Rx DDE: one row per block, rows are contiguous in memory */
+	mmio_write_32(qspi_dde_rx_base() + DDE_ADDRSTART, dde_addr);
+	mmio_write_32(qspi_dde_rx_base() + DDE_XCNT, block_len >> msize);
+	mmio_write_32(qspi_dde_rx_base() + DDE_XMOD, 1U << msize);
+	mmio_write_32(qspi_dde_rx_base() + DDE_YCNT, nblocks);
+	mmio_write_32(qspi_dde_rx_base() + DDE_YMOD, 1U << msize);
+
+	cfg = (msize << DDE_CFG_MSIZE_OFFSET) |
+	      (psize << DDE_CFG_PSIZE_OFFSET) |
+	      DDE_CFG_TWOD | DDE_CFG_WNR | DDE_CFG_SYNC | DDE_CFG_EN;
+	mmio_write_32(qspi_dde_rx_base() + DDE_CFG, cfg);
+
+	/* Set SPI->DDE trigger and enable receiver */
+	mmio_write_32(qspi_base() + SPI_RXCTL, SPI_RXCTL_REN | SPI_RXCTL_RTI |
+		      SPI_RXCTL_RWCEN | SPI_RXCTL_RDR_NOT_EMPTY);
+
+	/* Wait for DMA to complete. The timeout applies to each block */
+	armed = 1U;
+	prev_ycnt = nblocks;
+	timeout = timeout_init_us(QSPI_DATA_TIMEOUT_US);
+	while ((mmio_read_32(qspi_dde_rx_base() + DDE_STAT) & DDE_STAT_RUN) != DDE_STAT_STOPPED) {
+		/* The SPI stops once a block is received, arm the next one */
+		if ((armed < nblocks) &&
+		    ((mmio_read_32(qspi_base() + SPI_RWC) & SPI_RWC_MASK) == 0U)) {
+			mmio_clrbits_32(qspi_base() + SPI_RXCTL, SPI_RXCTL_RWCEN);
+			mmio_write_32(qspi_base() + SPI_RWC, block_len);
+			mmio_setbits_32(qspi_base() + SPI_RXCTL, SPI_RXCTL_RWCEN);
+			armed++;
+		}
+
+		ycnt = mmio_read_32(qspi_dde_rx_base() + DDE_YCNT_CUR);
+		if (ycnt != prev_ycnt) {
+			prev_ycnt = ycnt;
+			timeout = timeout_init_us(QSPI_DATA_TIMEOUT_US);
+		}
+
+		if (timeout_elapsed(timeout)) {
+			ERROR("%s: DDE rx timeout\n", __func__);
+			ret = -ETIMEDOUT;
+			break;
+		}
+	}
+
+	/* Clear SPI RXCTL and DDE CFG registers */
+	mmio_write_32(qspi_dde_rx_base() + DDE_CFG, 0);
+	mmio_write_32(qspi_base() + SPI_RXCTL, 0);
+
+	return ret;
+}
+
 static int adi_qspi_xfer(bool dir, uint8_t buswidth, uint8_t *buf, uint32_t size, uint8_t mem_inc)
 {
 	int ret = 0;
 	uint32_t rem_len;
+	uint32_t nblocks;
 	uint16_t transfer_len;
-	bool use_dma = adi_qspi_params.dma;
+	bool use_dma = adi_qspi_params.dma && (size >= QSPI_DMA_MIN_LEN);
 
 	if (size == 0)
 		/* Nothing to do */
@@ -391,6 +495,19 @@ static int adi_qspi_xfer(bool dir, uint8_t buswidth, uint8_t *buf, uint32_t size
 
 	/* Do transfer */
 	rem_len = size;
+
+	/* Pipeline all full blocks of a large DMA read in one go */
+	if (use_dma && (dir == SPI_MEM_DATA_IN) && (mem_inc == MEM_AUTO_INC) &&
+	    (rem_len > MAX_TRANSFER_WORD_COUNT)) {
+		nblocks = rem_len / MAX_TRANSFER_WORD_COUNT;
+		ret = adi_qspi_rx_xfer_2d(buf, MAX_TRANSFER_WORD_COUNT, nblocks);
+		if (ret != 0)
+			return ret;
+
+		rem_len -= nblocks * MAX_TRANSFER_WORD_COUNT;
+		buf += nblocks * MAX_TRANSFER_WORD_COUNT;
+	}
+
 	while (rem_len > 0U) {
 		/* Transfer length limited to MAX_TRANSFER_WORD_COUNT bytes (< 64KB) */
 		if (rem_len > MAX_TRANSFER_WORD_COUNT)
@@ -415,54 +532,155 @@ static int adi_qspi_xfer(bool dir, uint8_t buswidth, uint8_t *buf, uint32_t size
 	return ret;
 }
 
-static int adi_qspi_exec_op(const struct spi_mem_op *op)
+/* Send opcode, address and dummy bytes as a single TX FIFO burst */
+static int adi_qspi_send_header(const struct spi_mem_op *op)
+{
+	uint8_t hdr[QSPI_HEADER_MAX_BYTES];
+	unsigned int len = 0;
+	int ret;
+	int i;
+
+	hdr[len++] = op->cmd.opcode;
+
+	/* Address (shall be sent in Big Endian format) */
+	for (i = 0; i < op->addr.nbytes; i++)
+		hdr[len++] = (uint8_t)(op->addr.val >> (8 * (op->addr.nbytes - 1 - i)));
+
+	/* Dummy bytes are driven high, which leaves any mode bits inactive */
+	for (i = 0; i < op->dummy.nbytes; i++)
+		hdr[len++] = 0xFFU;
+
+	ret = adi_qspi_set_miom(op->cmd.buswidth);
+	if (ret != 0)
+		return ret;
+
+	return adi_qspi_tx_xfer(false, hdr, len, MEM_AUTO_INC);
+}
+
+/* Opcode, address and dummy phases can share one burst if they use the same bus width */
+static bool adi_qspi_can_batch_header(const struct spi_mem_op *op)
+{
+	if ((op->addr.nbytes != 0U) && (op->addr.buswidth != op->cmd.buswidth))
+		return false;
+
+	if ((op->dummy.nbytes != 0U) && (op->dummy.buswidth != op->cmd.buswidth))
+		return false;
+
+	return (1U + op->addr.nbytes + op->dummy.nbytes) <= QSPI_HEADER_MAX_BYTES;
+}
+
+static int adi_qspi_send_phases(const struct spi_mem_op *op)
 {
 	int i;
 	uint8_t addr_buf[DEVICE_ADDR_MAX_BYTES];
 	uint8_t dummy_buf;
 	int ret;
 
+	if (adi_qspi_can_batch_header(op))
+		return adi_qspi_send_header(op);
+
+	/* Command */
+	ret = adi_qspi_xfer(SPI_MEM_DATA_OUT, op->cmd.buswidth, (uint8_t *)&op->cmd.opcode, 1, MEM_AUTO_INC);
+	if (ret != 0)
+		return ret;
+
+	/* Address (shall be sent in Big Endian format */
+	for (i = 0; i < op->addr.nbytes; i++)
+		addr_buf[i] = (uint8_t)(op->addr.val >> (8 * (op->addr.nbytes - 1 - i)));
+
+	ret = adi_qspi_xfer(SPI_MEM_DATA_OUT, op->addr.buswidth, addr_buf, op->addr.nbytes, MEM_AUTO_INC);
+	if (ret != 0)
+		return ret;
+
+	/* Dummy clocks (0 or more) */
+	return adi_qspi_xfer(SPI_MEM_DATA_IN, op->dummy.buswidth, &dummy_buf, op->dummy.nbytes, MEM_NO_INC);
+}
+
+static int adi_qspi_exec_op(const struct spi_mem_op *op)
+{
+#ifndef ADI_TE_PLAT
+	uint64_t start;
+#endif
+	int ret;
+
 	VERBOSE("%s: cmd:%x mode:%d.%d.%d.%d addr:%lx len:%x\n",
 		__func__, op->cmd.opcode, op->cmd.buswidth, op->addr.buswidth,
 		op->dummy.buswidth, op->data.buswidth,
 		op->addr.val, op->data.nbytes);
 
 	if (op->cmd.opcode) {
+		if (op->addr.nbytes > DEVICE_ADDR_MAX_BYTES)
+			return -EINVAL;
+
 		/* Enable SPI (not strictly needed, but disabling first ensures
 		 * that internal HW machinery starts from a known state) */
 		mmio_clrbits_32(qspi_base() + SPI_CTL, 1);
 		mmio_setbits_32(qspi_base() + SPI_CTL, 1);
 
-		/* Command */
-		ret = adi_qspi_xfer(SPI_MEM_DATA_OUT, op->cmd.buswidth, (uint8_t *)&op->cmd.opcode, 1, MEM_AUTO_INC);
-		if (ret != 0)
-			return ret;
-
-		/* Address (shall be sent in Big Endian format */
-		if (op->addr.nbytes > DEVICE_ADDR_MAX_BYTES)
-			return -EINVAL;
-
-		for (i = 0; i < op->addr.nbytes; i++)
-			addr_buf[i] = (uint8_t)(op->addr.val >> (8 * (op->addr.nbytes - 1 - i)));
-
-		ret = adi_qspi_xfer(SPI_MEM_DATA_OUT, op->addr.buswidth, addr_buf, op->addr.nbytes, MEM_AUTO_INC);
-		if (ret != 0)
-			return ret;
-
-		/* Dummy clocks (0 or more) */
-		ret = adi_qspi_xfer(SPI_MEM_DATA_IN, op->dummy.buswidth, &dummy_buf, op->dummy.nbytes, MEM_NO_INC);
+		/* Command, address and dummy */
+		ret = adi_qspi_send_phases(op);
 		if (ret != 0)
 			return ret;
 
 		/* Transfer data */
+#ifndef ADI_TE_PLAT
+		start = read_cntpct_el0();
+#endif
 		ret = adi_qspi_xfer(op->data.dir, op->data.buswidth, op->data.buf, op->data.nbytes, MEM_AUTO_INC);
 		if (ret != 0)
 			return ret;
+
+#ifndef ADI_TE_PLAT
+		if (op->data.dir == SPI_MEM_DATA_IN) {
+			adi_qspi_rx_ticks += read_cntpct_el0() - start;
+			adi_qspi_rx_bytes += op->data.nbytes;
+		}
+#endif
 	}
 
 	return 0;
 }
 
+/*
+ * Issue a register read once and keep clocking it out with chip select held,
+ * until (value & mask) == match. SPI NOR devices repeat the status register
+ * for as long as the read continues, so the opcode is not resent per poll.
+ */
+static int adi_qspi_poll_status(const struct spi_mem_op *op, uint8_t mask,
+				uint8_t match, unsigned int timeout_us)
+{
+	uint64_t timeout;
+	uint8_t *val = op->data.buf;
+	int ret;
+
+	if ((op->data.dir != SPI_MEM_DATA_IN) || (op->data.nbytes != 1U) ||
+	    (op->addr.nbytes > DEVICE_ADDR_MAX_BYTES))
+		return -EINVAL;
+
+	mmio_clrbits_32(qspi_base() + SPI_CTL, 1);
+	mmio_setbits_32(qspi_base() + SPI_CTL, 1);
+
+	ret = adi_qspi_send_phases(op);
+	if (ret != 0)
+		return ret;
+
+	ret = adi_qspi_set_miom(op->data.buswidth);
+	if (ret != 0)
+		return ret;
+
+	timeout = timeout_init_us(timeout_us);
+	do {
+		ret = adi_qspi_rx_xfer(false, val, 1U, MEM_AUTO_INC);
+		if (ret != 0)
+			return ret;
+
+		if ((*val & mask) == match)
+			return 0;
+	} while (!timeout_elapsed(timeout));
+
+	return -ETIMEDOUT;
+}
+
 static int adi_qspi_claim_bus(unsigned int cs)
 {
 	(void)cs;
@@ -542,8 +760,17 @@ static const struct spi_bus_ops adi_qspi_bus_ops = {
 	.set_speed	= adi_qspi_set_speed,
 	.set_mode	= adi_qspi_set_mode,
 	.exec_op	= adi_qspi_exec_op,
+	.poll_status	= adi_qspi_poll_status,
 };
 
+#ifndef ADI_TE_PLAT
+void adi_qspi_get_rx_stats(uint64_t *bytes, uint64_t *ticks)
+{
+	*bytes = adi_qspi_rx_bytes;
+	*ticks = adi_qspi_rx_ticks;
+}
+#endif
+
 void adi_qspi_deinit(uintptr_t qspi_base, uintptr_t tx_dde_base, uintptr_t rx_dde_base)
 {
 	/* Disable Tx and Rx DMA channels */
@@ -9,12 +9,14 @@
 #include <drivers/delay_timer.h>
 #include <errno.h>
 #include <lib/mmio.h>
+#include <lib/utils_def.h>
 #include <stddef.h>
 #include <string.h>
 
 #include <drivers/adi/adi_te_interface.h>
 
 #include "adi_te_mailbox.h"
+#include <platform_def.h>
 
 #define HOST_ERROR_INVALID_ARGS (0x01UL)        /* 0x01 - Host error invalid arguments */
 #define HOST_ERROR_BUFFER       (0x02UL)
@@ -62,9 +64,12 @@ typedef enum {
 	ADI_ENCLAVE_RANDOM			= 0x184,
 } adi_enclave_api_id_t;
 
-static uint8_t te_buf[1024] __attribute__((aligned(sizeof(uint64_t))));    /* Buffer to transfer data through TE mailbox */
+static uint8_t te_buf[1024] __attribute__((aligned(CACHE_WRITEBACK_GRANULE)));    /* Buffer to transfer data through TE mailbox */
 static uintptr_t cur_ptr = (uintptr_t)te_buf;
 
+/* Chunk size when streaming data through te_buf, one half in flight while the other is copied */
+#define TE_BUF_HALF_SIZE        (sizeof(te_buf) / 2U)
+
 const char *adi_enclave_get_lifecycle_state_str(uintptr_t base_addr)
 {
 	switch (adi_enclave_get_lifecycle_state(base_addr)) {
@@ -214,17 +219,44 @@ static void buf_init(void)
 	memset(te_buf, 0, sizeof(te_buf));
 }
 
-/* Data sent through TE mailbox must be copied to te_buf prior to calling this function to be able to flush/invalidate memory */
-static int perform_enclave_transaction(uintptr_t base_addr, adi_enclave_api_id_t requestId, uint32_t args[], uint32_t numArgs)
+/*
+ * True if the TE can access [buf, buf + size) in place. Buffers the TE writes
+ * must also cover whole cache lines, so they can be invalidated afterwards
+ * without discarding neighbouring data.
+ */
+static bool is_te_shared_mem(uintptr_t buf, size_t size, bool te_writes)
+{
+#ifdef PLAT_TE_SHARED_MEM_SIZE
+	if ((buf < PLAT_TE_SHARED_MEM_BASE) || (size > PLAT_TE_SHARED_MEM_SIZE) ||
+	    ((buf - PLAT_TE_SHARED_MEM_BASE) > (PLAT_TE_SHARED_MEM_SIZE - size)) ||
+	    ((buf + size) > UINT32_MAX))
+		return false;
+
+	if (te_writes && (((buf | size) & (CACHE_WRITEBACK_GRANULE - 1U)) != 0U))
+		return false;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+ * Post a request without waiting for it to complete. [data, data + size) is the
+ * memory the TE accesses for this request, it is flushed before the request is
+ * made. Only one request can be in flight per mailbox.
+ */
+static int send_request(uintptr_t base_addr, adi_enclave_api_id_t requestId, const uint32_t args[], uint32_t numArgs,
+			uintptr_t data, size_t size)
 {
 	uint32_t i;
-	int ret;
 
 	if ((args == NULL && numArgs != 0) || (numArgs > NUM_MAILBOX_DATA_REGS))
 		return HOST_ERROR_INVALID_ARGS;
 
 	/* Flush cache */
-	flush_dcache_range((uintptr_t)te_buf, sizeof(te_buf));
+	if (size != 0U)
+		flush_dcache_range(data, size);
 
 	mmio_write_32(base_addr + MB_REGS_HRC0, requestId);
 
@@ -233,6 +265,15 @@ static int perform_enclave_transaction(uintptr_t base_addr, adi_enclave_api_id_t
 
 	signal_request_ready(base_addr);
 
+	return ADI_TE_RET_OK;
+}
+
+/* Wait for the request in flight, then invalidate [data, data + size) and read back the arguments */
+static int receive_response(uintptr_t base_addr, uint32_t args[], uint32_t numArgs, uintptr_t data, size_t size)
+{
+	uint32_t i;
+	int ret;
+
 	ret = wait_for_response(base_addr);
 	if (ret != ADI_TE_RET_OK) {
 		ERROR("Timed out waiting for Enclave mailbox response\n");
@@ -243,7 +284,8 @@ static int perform_enclave_transaction(uintptr_t base_addr, adi_enclave_api_id_t
 	ack_response(base_addr);
 
 	/* Invalidate cache */
-	inv_dcache_range((uintptr_t)te_buf, sizeof(te_buf));
+	if (size != 0U)
+		inv_dcache_range(data, size);
 
 	for (i = 0; i < numArgs; i++)
 		args[i] = mmio_read_32(base_addr + mb_regs_mdr[i]);
@@ -251,6 +293,45 @@ static int perform_enclave_transaction(uintptr_t base_addr, adi_enclave_api_id_t
 	return mmio_read_32(base_addr + MB_REGS_ERC1);
 }
 
+/* Data sent through TE mailbox must be copied to te_buf prior to calling this function to be able to flush/invalidate memory */
+static int perform_enclave_transaction(uintptr_t base_addr, adi_enclave_api_id_t requestId, uint32_t args[], uint32_t numArgs)
+{
+	int ret;
+
+	ret = send_request(base_addr, requestId, args, numArgs, (uintptr_t)te_buf, sizeof(te_buf));
+	if (ret != ADI_TE_RET_OK)
+		return ret;
+
+	return receive_response(base_addr, args, numArgs, (uintptr_t)te_buf, sizeof(te_buf));
+}
+
+/* Pass a caller buffer holding request data to the TE, in place if possible, otherwise through te_buf */
+static int perform_input_transaction(uintptr_t base_addr, adi_enclave_api_id_t requestId, const void *buf, uint32_t len)
+{
+	uint32_t args[2];
+	int ret;
+
+	args[1] = len;
+
+	if ((buf != NULL) && (len != 0U) && is_te_shared_mem((uintptr_t)buf, len, false)) {
+		args[0] = (uint32_t)(uintptr_t)buf;
+		ret = send_request(base_addr, requestId, args, 2, (uintptr_t)buf, len);
+		if (ret != ADI_TE_RET_OK)
+			return ret;
+		return receive_response(base_addr, args, 2, 0U, 0U);
+	}
+
+	buf_init();
+
+	ret = verify_buf_len(buf, len, 1, (uint32_t)SIZE_MAX);
+	if (ret != ADI_TE_RET_OK)
+		return ret;
+
+	args[0] = (uint32_t)reserve_buf((uintptr_t)buf, len);
+
+	return perform_enclave_transaction(base_addr, requestId, args, 2);
+}
+
 /* Tiny Enclave version */
 int adi_enclave_get_enclave_version(uintptr_t base_addr, uint8_t *output_buffer, uint32_t *o_buff_len)
 {
@@ -358,36 +439,12 @@ int adi_enclave_request_challenge(uintptr_t base_addr, chal_type_e chal_type, ui
  */
 int adi_enclave_priv_set_rma(uintptr_t base_addr, const uint8_t *cr_input_buffer, uint32_t input_buff_len)
 {
-	int ret;
-	uint32_t args[2];
-
-	buf_init();
-
-	ret = verify_buf_len(cr_input_buffer, input_buff_len, 1, (uint32_t)SIZE_MAX);
-	if (ret != ADI_TE_RET_OK)
-		return ret;
-
-	args[0] = (uint32_t)reserve_buf((uintptr_t)cr_input_buffer, input_buff_len);
-	args[1] = input_buff_len;
-
-	return perform_enclave_transaction(base_addr, ADI_ENCLAVE_PRIV_SET_RMA, args, 2);
+	return perform_input_transaction(base_addr, ADI_ENCLAVE_PRIV_SET_RMA, cr_input_buffer, input_buff_len);
 }
 
 int adi_enclave_priv_secure_debug_access(uintptr_t base_addr, const uint8_t *cr_input_buffer, uint32_t input_buff_len)
 {
-	int ret;
-	uint32_t args[2];
-
-	buf_init();
-
-	ret = verify_buf_len(cr_input_buffer, input_buff_len, 1, (uint32_t)SIZE_MAX);
-	if (ret != ADI_TE_RET_OK)
-		return ret;
-
-	args[0] = (uint32_t)reserve_buf((uintptr_t)cr_input_buffer, input_buff_len);
-	args[1] = input_buff_len;
-
-	return perform_enclave_transaction(base_addr, ADI_ENCLAVE_PRIV_SECURE_DEBUG_ACCESS, args, 2);
+	return perform_input_transaction(base_addr, ADI_ENCLAVE_PRIV_SECURE_DEBUG_ACCESS, cr_input_buffer, input_buff_len);
 }
 
 int adi_enclave_get_api_version(uintptr_t base_addr, uint8_t *output_buffer, uint32_t *o_buff_len)
@@ -421,19 +478,7 @@ int adi_enclave_get_api_version(uintptr_t base_addr, uint8_t *output_buffer, uin
 /* Request the enclave to enable a feature/features of the system by issuing a Feature Certificate (FCER) */
 int adi_enclave_enable_feature(uintptr_t base_addr, const uint8_t *input_buffer_fcer, uint32_t fcer_len)
 {
-	int ret;
-	uint32_t args[2];
-
-	buf_init();
-
-	ret = verify_buf_len(input_buffer_fcer, fcer_len, 1, (uint32_t)SIZE_MAX);
-	if (ret != ADI_TE_RET_OK)
-		return ret;
-
-	args[0] = (uint32_t)reserve_buf((uintptr_t)input_buffer_fcer, fcer_len);
-	args[1] = fcer_len;
-
-	return perform_enclave_transaction(base_addr, ADI_ENCLAVE_ENABLE_FEATURE, args, 2);
+	return perform_input_transaction(base_addr, ADI_ENCLAVE_ENABLE_FEATURE, input_buffer_fcer, fcer_len);
 }
 
 /* Get what's currently enabled in the system */
@@ -501,6 +546,26 @@ int adi_enclave_provision_host_keys(uintptr_t base_addr, const uintptr_t hst_key
 	unsigned int key_num;
 	uint32_t args[2];
 	host_keys_t *tmp_hst_keys;
+	bool shared;
+
+	/* Hand the key list over in place if the TE can read it and every key it points to */
+	shared = (hst_keys != 0U) && (hst_keys_size != 0U) && is_te_shared_mem(hst_keys, hst_keys_size, false);
+	tmp_hst_keys = (host_keys_t *)hst_keys;
+	for (key_num = 0; shared && (key_num < hst_keys_len); key_num++)
+		shared = (tmp_hst_keys[key_num].key != NULL) && (tmp_hst_keys[key_num].key_len != 0U) &&
+			 is_te_shared_mem((uintptr_t)tmp_hst_keys[key_num].key, tmp_hst_keys[key_num].key_len, false);
+
+	if (shared) {
+		args[0] = (uint32_t)hst_keys;
+		args[1] = hst_keys_len;
+		/* Clean the keys, send_request() cleans the list itself */
+		for (key_num = 0; key_num < hst_keys_len; key_num++)
+			flush_dcache_range((uintptr_t)tmp_hst_keys[key_num].key, tmp_hst_keys[key_num].key_len);
+		ret = send_request(base_addr, ADI_ENCLAVE_PROV_HSTKEY, args, 2, hst_keys, hst_keys_size);
+		if (ret != ADI_TE_RET_OK)
+			return ret;
+		return receive_response(base_addr, args, 2, 0U, 0U);
+	}
 
 	buf_init();
 
@@ -642,24 +707,61 @@ int adi_enclave_get_huk(uintptr_t base_addr, uint8_t *output_buffer, uint32_t *o
 }
 
 
+/*
+ * Buffers the TE can write in place are filled with a single request. Others are
+ * filled in chunks through te_buf: each chunk is requested into one half of te_buf
+ * while the previous one is copied out of the other half.
+ */
 int adi_enclave_random_bytes(uintptr_t base_addr, void *output_buffer, uint32_t o_buff_len)
 {
 	uintptr_t buf = (uintptr_t)output_buffer;
+	uintptr_t slot;
+	uintptr_t prev_slot = 0U;
+	uint32_t prev_len = 0U;
+	uint32_t offset;
+	uint32_t len;
 	uint32_t args[2];
-	int ret, status;
+	int status;
 
-	buf_init();
+	if ((output_buffer == NULL) || (o_buff_len == 0U))
+		return HOST_ERROR_INVALID_ARGS;
 
-	ret = verify_buf_len((const void *)buf, o_buff_len, 1, (uint32_t)SIZE_MAX);
-	if (ret != ADI_TE_RET_OK)
-		return ret;
+	if (is_te_shared_mem(buf, o_buff_len, true)) {
+		args[0] = (uint32_t)buf;
+		args[1] = o_buff_len;
+		status = send_request(base_addr, ADI_ENCLAVE_RANDOM, args, 2, buf, o_buff_len);
+		if (status != ADI_TE_RET_OK)
+			return status;
+		return receive_response(base_addr, args, 2, buf, o_buff_len);
+	}
+
+	for (offset = 0U; offset < o_buff_len; offset += len) {
+		len = MIN(o_buff_len - offset, (uint32_t)TE_BUF_HALF_SIZE);
+		slot = (uintptr_t)te_buf + (((offset / TE_BUF_HALF_SIZE) % 2U) * TE_BUF_HALF_SIZE);
 
-	args[0] = (uint32_t)reserve_buf(buf, o_buff_len);
-	args[1] = (uint32_t)o_buff_len;
+		if (prev_len != 0U) {
+			status = receive_response(base_addr, args, 2, prev_slot, prev_len);
+			if (status != 0)
+				return status;
+		}
+
+		args[0] = (uint32_t)slot;
+		args[1] = len;
+		status = send_request(base_addr, ADI_ENCLAVE_RANDOM, args, 2, slot, len);
+		if (status != ADI_TE_RET_OK)
+			return status;
+
+		/* Overlaps with the TE generating the chunk just requested */
+		if (prev_len != 0U)
+			memcpy((void *)(buf + offset - prev_len), (void *)prev_slot, prev_len);
+
+		prev_slot = slot;
+		prev_len = len;
+	}
 
-	status = perform_enclave_transaction(base_addr, ADI_ENCLAVE_RANDOM, args, 2);
+	status = receive_response(base_addr, args, 2, prev_slot, prev_len);
 	if (status == 0)
-		memcpy(output_buffer, (void *)(uintptr_t)args[0], o_buff_len);
+		memcpy((void *)(buf + offset - prev_len), (void *)prev_slot, prev_len);
 
 	return status;
 }
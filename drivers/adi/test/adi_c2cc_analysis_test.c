@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/utils_def.h>
+#include <drivers/adi/adi_c2cc.h>
+#include <drivers/adi/adi_c2cc_analysis.h>
+
+/************************** Test INSTRUCTIONS ***************************/
+/* This test needs no C2C hardware. On target:
+ * 1. Add the following in drivers/adi/test/test_framework.c
+ *    -> extern int adi_c2cc_analysis_test(void);
+ *    -> Call adi_c2cc_analysis_test() inside test_main()
+ * 2. Include this file and drivers/adi/c2cc/adi_c2cc_analysis.c in
+ *    plat/adi/adrv/adrv906x/plat_adrv906x.mk
+ * On the build host, run "make -C drivers/adi/test/host c2cc".
+ ************************************************************************/
+
+/*
+ * TRAINSTAT3 words of every trim, in the layout logged by
+ * adi_c2cc_analyze_train_data() at LOG_LEVEL_VERBOSE. A capture from a
+ * board can be pasted in as a new case.
+ */
+static const uint32_t c2c_stats_aligned[ADI_C2C_TRIM_MAX] = {
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+};
+
+static const uint32_t c2c_stats_skewed[ADI_C2C_TRIM_MAX] = {
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111100, 0x11111100, 0x11001100, 0x11001100, 0x11000000, 0x11000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000011, 0x00000011,
+	0x00110011, 0x00110011, 0x00111111, 0x00111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+};
+
+static const uint32_t c2c_stats_glitch[ADI_C2C_TRIM_MAX] = {
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00110000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+};
+
+static const uint32_t c2c_stats_split[ADI_C2C_TRIM_MAX] = {
+	0x11001100, 0x11001100, 0x11001100, 0x11001100, 0x11001100, 0x11001100, 0x11001100, 0x11001100,
+	0x11111111, 0x11111111, 0x00110011, 0x00110011, 0x00110011, 0x00110011, 0x00110011, 0x00110011,
+	0x00110011, 0x00110011, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+};
+
+static const uint32_t c2c_stats_late[ADI_C2C_TRIM_MAX] = {
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+};
+
+static const uint32_t c2c_stats_closed[ADI_C2C_TRIM_MAX] = {
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+	0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111, 0x11111111,
+};
+
+/*
+ * Expected results: trim, eye_width and delays are those of the exhaustive
+ * sweep. sweep_measured is the number of trims a coarse sweep of
+ * C2C_SWEEP_STEP measures, sweep_fallback whether the trims it picks fail
+ * the verify margin so the exhaustive sweep has to be run.
+ */
+struct c2c_analysis_case {
+	const char *name;
+	const uint32_t *stats;
+	uint8_t trim;
+	size_t eye_width;
+	uint8_t delays[ADI_C2C_LANE_COUNT];
+	uint8_t sweep_measured;
+	bool sweep_fallback;
+};
+
+static const struct c2c_analysis_case c2c_analysis_cases[] = {
+	/* every lane open over 20..39 */
+	{ "aligned", c2c_stats_aligned, 30, 20, { 0, 0, 0, 0 }, 23, false },
+	/* lanes open over 10..29, 14..33, 12..31 and 16..35 */
+	{ "skewed", c2c_stats_skewed, 23, 14, { 6, 2, 4, 0 }, 29, false },
+	/* open over 10..49, lane 2 fails at 30 inside a gap the coarse sweep fills */
+	{ "glitch", c2c_stats_glitch, 20, 20, { 0, 0, 0, 0 }, 23, true },
+	/* no combined eye, the delays are what lines the lanes up for a retrain */
+	{ "split", c2c_stats_split, ADI_C2C_TRIM_MAX, 8, { 10, 0, 10, 0 }, 26, true },
+	/* open above ADI_C2C_MAX_TRIM_CENTER only */
+	{ "late", c2c_stats_late, ADI_C2C_TRIM_MAX, 0, { 0, 0, 0, 0 }, 20, true },
+	{ "closed", c2c_stats_closed, ADI_C2C_TRIM_MAX, 0, { 0, 0, 0, 0 }, 17, true },
+};
+
+#define C2C_ANALYSIS_RUNS 100
+#define C2C_SWEEP_STEP (ADI_C2C_MIN_WINDOW_SIZE - 1)
+
+/* Statistics the coarse sweep measures from */
+static const uint32_t *c2c_sweep_source;
+
+static bool c2c_sweep_measure(uint8_t trim, uint32_t *p2s_stat, uint32_t *s2p_stat)
+{
+	*p2s_stat = c2c_sweep_source[trim];
+	*s2p_stat = c2c_sweep_source[trim];
+	return true;
+}
+
+/* Same check as adi_c2cc_verify_training(), against the recorded statistics */
+static bool c2c_sweep_verify(uint8_t trim)
+{
+	int offset;
+
+	if ((trim < ADI_C2C_VERIFY_MARGIN) || (trim + ADI_C2C_VERIFY_MARGIN >= ADI_C2C_TRIM_MAX))
+		return false;
+
+	for (offset = -ADI_C2C_VERIFY_MARGIN; offset <= ADI_C2C_VERIFY_MARGIN; offset++)
+		if (c2c_sweep_source[trim + offset] != 0)
+			return false;
+
+	return true;
+}
+
+/*
+ * Pick a trim the way adi_c2cc_enable_high_speed() does with a coarse step:
+ * analyze the coarse sweep, then measure the result and fall back to the
+ * exhaustive sweep if it does not hold. The trim must match the exhaustive one.
+ */
+static bool c2c_sweep_check(const struct c2c_analysis_case *c)
+{
+	uint32_t p2s_stats[ADI_C2C_TRIM_MAX];
+	uint32_t s2p_stats[ADI_C2C_TRIM_MAX];
+	unsigned int measured = 0;
+	unsigned int full = 0;
+	bool fallback;
+	uint8_t trim;
+
+	c2c_sweep_source = c->stats;
+	memset(p2s_stats, 0, sizeof(p2s_stats));
+	memset(s2p_stats, 0, sizeof(s2p_stats));
+
+	if (!adi_c2cc_coarse_sweep(p2s_stats, s2p_stats, C2C_SWEEP_STEP, false, c2c_sweep_measure, &measured))
+		return false;
+
+	trim = adi_c2cc_find_optimal_trim(p2s_stats, ADI_C2C_MIN_WINDOW_SIZE, ADI_C2C_TRIM_DELAY_MAX, ADI_C2C_MAX_TRIM_CENTER, NULL, NULL);
+	fallback = !c2c_sweep_verify(trim);
+	if (fallback) {
+		/* a step of 1 measures every trim */
+		if (!adi_c2cc_coarse_sweep(p2s_stats, s2p_stats, 1, false, c2c_sweep_measure, &full))
+			return false;
+		trim = adi_c2cc_find_optimal_trim(p2s_stats, ADI_C2C_MIN_WINDOW_SIZE, ADI_C2C_TRIM_DELAY_MAX, ADI_C2C_MAX_TRIM_CENTER, NULL, NULL);
+	}
+
+	if ((trim != c->trim) || (measured != c->sweep_measured) || (fallback != c->sweep_fallback)) {
+		printf("c2c sweep %s: FAIL trim %u measured %u fallback %d (expected %u measured %u fallback %d)\n",
+		       c->name, trim, measured, fallback, c->trim, c->sweep_measured, c->sweep_fallback);
+		return false;
+	}
+
+	return true;
+}
+
+int adi_c2cc_analysis_test(void)
+{
+	uint32_t stats[ADI_C2C_TRIM_MAX];
+	uint8_t delays[ADI_C2C_LANE_COUNT];
+	const struct c2c_analysis_case *c;
+	size_t eye_width;
+	uint64_t ticks;
+	uint8_t trim;
+	unsigned int failures = 0;
+	unsigned int i;
+	unsigned int run;
+
+	for (i = 0; i < ARRAY_SIZE(c2c_analysis_cases); i++) {
+		c = &c2c_analysis_cases[i];
+		memcpy(stats, c->stats, sizeof(stats));
+
+		/* the search logs as it goes, keep that out of the timing */
+		tf_log_set_max_level(LOG_LEVEL_NONE);
+		ticks = read_cntpct_el0();
+		for (run = 0; run < C2C_ANALYSIS_RUNS; run++) {
+			memset(delays, 0, sizeof(delays));
+			eye_width = 0;
+			trim = adi_c2cc_find_optimal_trim(stats, ADI_C2C_MIN_WINDOW_SIZE, ADI_C2C_TRIM_DELAY_MAX, ADI_C2C_MAX_TRIM_CENTER, delays, &eye_width);
+		}
+		ticks = read_cntpct_el0() - ticks;
+		tf_log_set_max_level(LOG_LEVEL);
+
+		if ((trim != c->trim) || (eye_width != c->eye_width) || (memcmp(delays, c->delays, sizeof(delays)) != 0)) {
+			printf("c2c analysis %s: FAIL trim %u eye %lu delays %u,%u,%u,%u (expected %u eye %lu delays %u,%u,%u,%u)\n",
+			       c->name, trim, eye_width, delays[0], delays[1], delays[2], delays[3],
+			       c->trim, c->eye_width, c->delays[0], c->delays[1], c->delays[2], c->delays[3]);
+			failures++;
+		} else if (!c2c_sweep_check(c)) {
+			failures++;
+		} else {
+			printf("c2c analysis %s: pass, %lu ticks per search, %u of %u trims measured by the coarse sweep%s\n",
+			       c->name, (unsigned long)(ticks / C2C_ANALYSIS_RUNS), c->sweep_measured, ADI_C2C_TRIM_MAX,
+			       c->sweep_fallback ? ", then the exhaustive sweep" : "");
+		}
+	}
+
+	return (failures == 0U) ? 0 : -1;
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+#include <drivers/spi_nor.h>
+
+/************************** Test INSTRUCTIONS ***************************/
+/* SFDP checks of the SPI NOR driver, run by adi_qspi_test() on target once
+ * the QSPI controller is set up. They only go through spi_nor_*() and the
+ * platform's plat_get_nor_data(), so the host build in drivers/adi/test/host
+ * runs them against a simulated flash: "make -C drivers/adi/test/host sfdp".
+ *
+ * BUF_LEN    : Read and write buffers' size (in bytes)
+ * BUFFER_ADDR: Specify the location of read/write buffers
+ * DEVICE_ADDR: Flash memory address used when the flash is 16 MB or less
+ ************************************************************************/
+
+#define BUF_LEN       10000
+#define DEVICE_ADDR   0x00000000
+#define HIGH_ADDR     0x01000000        /* First byte past a 3-byte address */
+//#define BUFFER_ADDR   0x00500000
+
+/* Read len bytes at addr and compare them with expected */
+static int adi_qspi_check(size_t addr, const uint8_t *expected, uint8_t *bufferRD, size_t len)
+{
+	size_t rd_len = 0;
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		bufferRD[i] = ~expected[i];
+
+	if (spi_nor_read(addr, (uintptr_t)bufferRD, len, &rd_len) != 0 || rd_len != len) {
+		printf("Failed to Read %zu bytes from nor-flash address 0x%lx \n", len, addr);
+		return -1;
+	}
+
+	for (i = 0; i < len; i++)
+		if (bufferRD[i] != expected[i]) {
+			printf("nor-flash address 0x%lx reads 0x%02x, expected 0x%02x\n", addr + i, bufferRD[i], expected[i]);
+			return -1;
+		}
+
+	return 0;
+}
+
+static int adi_qspi_write_check(size_t addr, const uint8_t *bufferWR, uint8_t *bufferRD, size_t len)
+{
+	if (spi_nor_write(addr, (uintptr_t)bufferWR, len) != 0) {
+		printf("Failed to Write %zu bytes to nor-flash address 0x%lx \n", len, addr);
+		return -1;
+	}
+
+	return adi_qspi_check(addr, bufferWR, bufferRD, len);
+}
+
+static const struct {
+	const char *name;
+	size_t addr;
+} high_cases[] = {
+	{ "above 16 MB",  HIGH_ADDR + BUF_LEN },
+	{ "across 16 MB", HIGH_ADDR - (BUF_LEN / 2) },
+};
+
+static int adi_qspi_test_high(unsigned long long sz, uint8_t *bufferWR, uint8_t *bufferRD, uint8_t *bufferGD)
+{
+	int ret = 0;
+	size_t addr;
+	size_t guard_addr;
+	size_t guard_len;
+	unsigned int c;
+	int i;
+
+	if (sz < HIGH_ADDR + 2 * BUF_LEN) {
+		printf("nor-flash is 0x%llx bytes, skipping writes above 16 MB\n", sz);
+		return 0;
+	}
+
+	for (c = 0; c < ARRAY_SIZE(high_cases); c++) {
+		addr = high_cases[c].addr;
+
+		/* The offsets a 3-byte address would wrap the bytes above 16 MB to */
+		guard_addr = MAX(addr, (size_t)HIGH_ADDR) - HIGH_ADDR;
+		guard_len = addr + BUF_LEN - MAX(addr, (size_t)HIGH_ADDR);
+		for (i = 0; i < (int)guard_len; i++)
+			bufferGD[i] = 0xA5;
+		ret = adi_qspi_write_check(guard_addr, bufferGD, bufferRD, guard_len);
+
+		/* Arbitrary data, then only clear bits (no erase), then set bits again (erase) */
+		for (i = 0; i < BUF_LEN; i++)
+			bufferWR[i] = (i % 251) ^ 0x3C;
+		if (ret == 0)
+			ret = adi_qspi_write_check(addr, bufferWR, bufferRD, BUF_LEN);
+
+		for (i = 0; i < BUF_LEN; i++)
+			bufferWR[i] &= 0xF0;
+		if (ret == 0)
+			ret = adi_qspi_write_check(addr, bufferWR, bufferRD, BUF_LEN);
+
+		for (i = 0; i < BUF_LEN; i++)
+			bufferWR[i] |= 0x0F;
+		if (ret == 0)
+			ret = adi_qspi_write_check(addr, bufferWR, bufferRD, BUF_LEN);
+
+		if (ret == 0)
+			ret = adi_qspi_check(guard_addr, bufferGD, bufferRD, guard_len);
+
+		printf("Write %s at 0x%lx: %s\n", high_cases[c].name, addr, (ret == 0) ? "PASS" : "KO");
+		if (ret != 0)
+			return -1;
+	}
+
+	return 0;
+}
+
+static bool adi_qspi_is_4b_opcode(uint8_t opcode)
+{
+	switch (opcode) {
+	case SPI_NOR_OP_READ_4B:
+	case SPI_NOR_OP_READ_FAST_4B:
+	case SPI_NOR_OP_READ_1_1_2_4B:
+	case SPI_NOR_OP_READ_1_2_2_4B:
+	case SPI_NOR_OP_READ_1_1_4_4B:
+	case SPI_NOR_OP_READ_1_4_4_4B:
+	case SPI_NOR_OP_PAGE_PROGRAM_4B:
+	case SPI_NOR_OP_WRITE_1_1_4_4B:
+	case SPI_NOR_OP_WRITE_1_4_4_4B:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/*
+ * Check the ops picked from SFDP, with its 4-byte address opcodes allowed or
+ * not (bank switching), then run the writes above 16 MB with them.
+ */
+int adi_qspi_test_sfdp(bool no_4b)
+{
+	int ret = 0;
+	bool use_4b;
+	size_t addr;
+	size_t len = 0;
+	unsigned int ersz;
+	unsigned long long sz;
+	struct nor_device *dev = spi_nor_get_device();
+	struct nor_device plat;
+	struct spi_mem_op sfdp_read;
+
+#ifdef BUFFER_ADDR
+	uint8_t *bufferWR = (uint8_t *)(BUFFER_ADDR + 2 * BUF_LEN);
+	uint8_t *bufferRD = (uint8_t *)(BUFFER_ADDR + 3 * BUF_LEN);
+	uint8_t *bufferGD = (uint8_t *)(BUFFER_ADDR + 4 * BUF_LEN);
+#else
+	static uint8_t bufWR[BUF_LEN] = { 0 };
+	static uint8_t bufRD[BUF_LEN] = { 0 };
+	static uint8_t bufGD[BUF_LEN] = { 0 };
+	uint8_t *bufferWR = (uint8_t *)bufWR;
+	uint8_t *bufferRD = (uint8_t *)bufRD;
+	uint8_t *bufferGD = (uint8_t *)bufGD;
+#endif
+
+	if (no_4b)
+		dev->flags |= SPI_NOR_NO_4B_OPS;
+	else
+		dev->flags &= ~SPI_NOR_NO_4B_OPS;
+
+	ret = spi_nor_init(&sz, &ersz);
+	if (ret != 0) {
+		printf("SPI nor flash init failed\n");
+		return -1;
+	}
+
+	zeromem(&plat, sizeof(plat));
+	plat_get_nor_data(&plat);
+
+	printf("SFDP%s: read 0x%02x 1-%u-%u, %u address bytes, %u dummy bytes, write 0x%02x, erase 0x%02x\n",
+	       no_4b ? " (4BAIT ignored)" : "", dev->read_op.cmd.opcode, dev->read_op.addr.buswidth,
+	       dev->read_op.data.buswidth, dev->read_op.addr.nbytes, dev->read_op.dummy.nbytes,
+	       dev->write_op.cmd.opcode, dev->erase_op.cmd.opcode);
+
+	/* The read mode may not use more data lines than the platform wired up */
+	if (dev->read_op.data.buswidth > plat.read_op.data.buswidth) {
+		printf("SFDP read mode uses %u data lines, the platform %u\n",
+		       dev->read_op.data.buswidth, plat.read_op.data.buswidth);
+		return -1;
+	}
+
+	/* 4-byte opcodes replace bank switching for every op, or for none */
+	use_4b = dev->read_op.addr.nbytes == 4U;
+	if (use_4b) {
+		if (no_4b || ((dev->flags & SPI_NOR_USE_BANK) != 0U) ||
+		    !adi_qspi_is_4b_opcode(dev->read_op.cmd.opcode) ||
+		    !adi_qspi_is_4b_opcode(dev->write_op.cmd.opcode) ||
+		    (dev->write_op.addr.nbytes != 4U) || (dev->erase_op.addr.nbytes != 4U) ||
+		    (dev->erase_op.cmd.opcode == plat.erase_op.cmd.opcode)) {
+			printf("SFDP 4-byte address opcodes only partly applied\n");
+			return -1;
+		}
+	} else {
+		if ((dev->write_op.addr.nbytes != 3U) || (dev->erase_op.addr.nbytes != 3U) ||
+		    ((sz > HIGH_ADDR) && ((dev->flags & SPI_NOR_USE_BANK) == 0U))) {
+			printf("3-byte addresses without bank switching\n");
+			return -1;
+		}
+	}
+
+	/* The SFDP read mode returns what a single line read does, across 16 MB if there is one */
+	addr = (sz >= HIGH_ADDR + BUF_LEN) ? HIGH_ADDR - (BUF_LEN / 2) : DEVICE_ADDR;
+	sfdp_read = dev->read_op;
+	zeromem(&dev->read_op, sizeof(struct spi_mem_op));
+	dev->read_op.cmd.opcode = use_4b ? SPI_NOR_OP_READ_4B : SPI_NOR_OP_READ;
+	dev->read_op.cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	dev->read_op.addr.nbytes = sfdp_read.addr.nbytes;
+	dev->read_op.addr.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	dev->read_op.data.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	dev->read_op.data.dir = SPI_MEM_DATA_IN;
+	ret = spi_nor_read(addr, (uintptr_t)bufferWR, BUF_LEN, &len);
+	dev->read_op = sfdp_read;
+	if (ret != 0 || len != BUF_LEN) {
+		printf("Failed to Read %d bytes from nor-flash address 0x%lx \n", BUF_LEN, addr);
+		return -1;
+	}
+
+	ret = adi_qspi_check(addr, bufferWR, bufferRD, BUF_LEN);
+	if (ret != 0)
+		return -1;
+
+	return adi_qspi_test_high(sz, bufferWR, bufferRD, bufferGD);
+}
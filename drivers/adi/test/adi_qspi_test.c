@@ -41,7 +41,8 @@
  * 1. Add the following in drivers/adi/test/test_framework.c
  *    -> extern int adi_qspi_test(void)
  *    -> Call adi_qspi_test() inside test_main()
- * 2. Include this file in plat/adi/adrv/adrv906x/plat_adrv906x.mk
+ * 2. Include this file and adi_qspi_sfdp_test.c in
+ *    plat/adi/adrv/adrv906x/plat_adrv906x.mk
  * 3. Feel free to modify the test conditions:
  *    BUF_LEN    : Read and write buffers' size (in bytes)
  *    BUFFER_ADDR: Specify the location of read/write buffers
@@ -50,6 +51,13 @@
  * Test functionality:
  * - write BUFFER_LEN bytes to flash memory, read-back the same emory area and
  *   check that was successfully
+ * - check the read mode and 4-byte address opcodes picked from SFDP, with and
+ *   without its 4BAIT table (bank switching), and compare reads in that mode
+ *   with single line reads
+ * - in both cases, on flashes larger than 16 MB, write above and across 16 MB,
+ *   with data that needs an erase and with data that only clears bits
+ *   (programmed without an erase), and check the same offsets below 16 MB are
+ *   left untouched
  *
  * Note: The write operation performs write enable/disable, erase and program
  * operations.
@@ -394,10 +402,14 @@ static int adi_qspi_playground(bool use_dma)
 	return ret;
 }
 
+/* SFDP read mode and 4-byte address checks, in adi_qspi_sfdp_test.c */
+int adi_qspi_test_sfdp(bool no_4b);
 
 int adi_qspi_test()
 {
 	int ret = 0;
+	unsigned int ersz;
+	unsigned long long sz;
 	/* Feel free to enable/disable DMA support */
 	int dma = false;
 
@@ -406,6 +418,15 @@ int adi_qspi_test()
 	/* SPI test test */
 	(void)&adi_qspi_playground;
 	ret = adi_qspi_test_1();
+	if (ret == 0)
+		ret = adi_qspi_test_sfdp(false);
+	if (ret == 0)
+		ret = adi_qspi_test_sfdp(true);
+
+	/* Back to the ops SFDP picks by default */
+	spi_nor_get_device()->flags &= ~SPI_NOR_NO_4B_OPS;
+	if (spi_nor_init(&sz, &ersz) != 0)
+		ret = -1;
 	printf("Test QSPI: %s\n", (ret == 0) ? "PASS" : "KO");
 
 	adi_qspi_drop();
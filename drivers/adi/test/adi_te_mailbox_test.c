@@ -1,3 +1,4 @@
+#include <arch_helpers.h>
 #include <drivers/adi/adi_te_interface.h>
 #include <lib/mmio.h>
 #include <lib/utils.h>
@@ -171,6 +172,20 @@ int adi_te_mailbox_test(void)
 	else
 		printf("Status get random bytes: %d\n", status);
 
+	/* Random bytes throughput, in place (cache line aligned) and through the mailbox buffer (unaligned) */
+	static uint8_t random_buf[4096 + 1] __aligned(CACHE_WRITEBACK_GRANULE);
+	uint64_t ticks;
+
+	ticks = read_cntpct_el0();
+	status = adi_enclave_random_bytes(TE_MAILBOX_BASE, random_buf, 4096);
+	ticks = read_cntpct_el0() - ticks;
+	printf("Random bytes 4 KB in place: status %d, %lu ticks\n", status, ticks);
+
+	ticks = read_cntpct_el0();
+	status = adi_enclave_random_bytes(TE_MAILBOX_BASE, &random_buf[1], 4096);
+	ticks = read_cntpct_el0() - ticks;
+	printf("Random bytes 4 KB through mailbox buffer: status %d, %lu ticks\n", status, ticks);
+
 	/* Mailbox #12 */
 	/* To test this create a new otp binary with the following steps:
 	 * 1. Lifecycle ADI_PROV_ENC
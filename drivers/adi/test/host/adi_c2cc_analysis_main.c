@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+int adi_c2cc_analysis_test(void);
+
+int main(void)
+{
+	return (adi_c2cc_analysis_test() == 0) ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <lib/utils_def.h>
+#include <drivers/spi_nor.h>
+
+#include "spi_nor_flash_model.h"
+
+int adi_qspi_test_sfdp(bool no_4b);
+
+#define ALL_READS	(FLASH_MODEL_READ_1_1_2 | FLASH_MODEL_READ_1_2_2 | \
+			 FLASH_MODEL_READ_1_1_4 | FLASH_MODEL_READ_1_4_4)
+#define OUTPUT_READS	(FLASH_MODEL_READ_1_1_2 | FLASH_MODEL_READ_1_1_4)
+
+/* Read op SFDP must pick for each flash and platform width */
+static const struct {
+	uint32_t read_modes;
+	unsigned int width;
+	uint8_t opcode;
+	uint8_t opcode_4b;
+	uint8_t addr_buswidth;
+} sfdp_cases[] = {
+	{ ALL_READS, 4U, SPI_NOR_OP_READ_1_4_4, SPI_NOR_OP_READ_1_4_4_4B, 4U },
+	{ ALL_READS, 2U, SPI_NOR_OP_READ_1_2_2, SPI_NOR_OP_READ_1_2_2_4B, 2U },
+	{ ALL_READS, 1U, SPI_NOR_OP_READ_FAST, SPI_NOR_OP_READ_FAST_4B, 1U },
+	{ OUTPUT_READS, 4U, SPI_NOR_OP_READ_1_1_4, SPI_NOR_OP_READ_1_1_4_4B, 1U },
+	{ OUTPUT_READS, 2U, SPI_NOR_OP_READ_1_1_2, SPI_NOR_OP_READ_1_1_2_4B, 1U },
+	{ OUTPUT_READS, 1U, SPI_NOR_OP_READ_FAST, SPI_NOR_OP_READ_FAST_4B, 1U },
+};
+
+static int sfdp_run(unsigned int c, bool bait, bool no_4b)
+{
+	struct flash_model_config cfg = {
+		.read_modes	= sfdp_cases[c].read_modes,
+		.bait		= bait,
+		.width		= sfdp_cases[c].width,
+	};
+	struct nor_device *dev = spi_nor_get_device();
+	bool use_4b = bait && !no_4b;
+	uint8_t opcode = use_4b ? sfdp_cases[c].opcode_4b : sfdp_cases[c].opcode;
+
+	printf("flash %s, %u data lines, %s4BAIT%s\n",
+	       (cfg.read_modes == ALL_READS) ? "1-4-4" : "1-1-4", cfg.width,
+	       bait ? "" : "no ", no_4b ? " (ignored)" : "");
+
+	flash_model_setup(&cfg);
+	memset(dev, 0, sizeof(*dev));
+
+	if (adi_qspi_test_sfdp(no_4b) != 0)
+		return -1;
+
+	if ((dev->read_op.cmd.opcode != opcode) ||
+	    (dev->read_op.addr.buswidth != sfdp_cases[c].addr_buswidth) ||
+	    (dev->read_op.data.buswidth != cfg.width) ||
+	    (dev->read_op.addr.nbytes != (use_4b ? 4U : 3U))) {
+		printf("FAIL: read 0x%02x 1-%u-%u, expected 0x%02x 1-%u-%u\n",
+		       dev->read_op.cmd.opcode, dev->read_op.addr.buswidth, dev->read_op.data.buswidth,
+		       opcode, sfdp_cases[c].addr_buswidth, cfg.width);
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	unsigned int failures = 0U;
+	unsigned int runs = 0U;
+	unsigned int c;
+	int bait;
+	int no_4b;
+
+	for (c = 0U; c < ARRAY_SIZE(sfdp_cases); c++)
+		for (bait = 1; bait >= 0; bait--)
+			for (no_4b = 0; no_4b <= 1; no_4b++) {
+				runs++;
+				if (sfdp_run(c, bait != 0, no_4b != 0) != 0)
+					failures++;
+			}
+
+	printf("SFDP: %u of %u runs passed\n", runs - failures, runs);
+
+	return (failures == 0U) ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DEBUG_H
+#define DEBUG_H
+
+/* Host build: stands in for include/common/debug.h, logging is dropped */
+
+#include <stdio.h>
+
+#define LOG_LEVEL_NONE		0U
+#define LOG_LEVEL_ERROR		10U
+#define LOG_LEVEL_NOTICE	20U
+#define LOG_LEVEL_WARNING	30U
+#define LOG_LEVEL_INFO		40U
+#define LOG_LEVEL_VERBOSE	50U
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL		LOG_LEVEL_NONE
+#endif
+
+#define ERROR(...)		do { } while (0)
+#define NOTICE(...)		do { } while (0)
+#define WARN(...)		do { } while (0)
+#define INFO(...)		do { } while (0)
+#define VERBOSE(...)		do { } while (0)
+
+static inline void tf_log_set_max_level(unsigned int log_level)
+{
+	(void)log_level;
+}
+
+#endif /* DEBUG_H */
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef UTILS_H
+#define UTILS_H
+
+/* Host build: stands in for include/lib/utils.h */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static inline void zeromem(void *mem, size_t length)
+{
+	memset(mem, 0, length);
+}
+
+#endif /* UTILS_H */
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Simulated SPI NOR flash behind spi_mem_exec_op(), for host builds of the
+ * SPI NOR driver tests. It answers SFDP reads from JESD216 tables built per
+ * configuration, keeps a 3-byte address extended address register, and
+ * rejects any op whose opcode, address bytes, bus widths or dummy cycles do
+ * not match what the flash advertises or the platform wired up.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lib/utils_def.h>
+#include <drivers/spi_nor.h>
+
+#include "spi_nor_flash_model.h"
+
+#define SFDP_SIZE		256U
+#define SFDP_BFPT_OFFSET	0x30U
+#define SFDP_4BAIT_OFFSET	0x80U
+
+#define SECTOR_SIZE		0x1000U
+#define BLOCK_SIZE		0x10000U
+#define PAGE_SIZE		0x100U
+
+/* Protocol of each data op: address bytes and lines, dummy cycles, data lines */
+static const struct flash_model_op {
+	uint8_t opcode;
+	uint8_t addr_nbytes;
+	uint8_t addr_buswidth;
+	uint8_t dummy_cycles;
+	uint8_t data_buswidth;
+	uint32_t read_mode;		/* BFPT support bit, 0 if always there */
+} flash_model_ops[] = {
+	{ SPI_NOR_OP_READ, 3U, 1U, 0U, 1U, 0U },
+	{ SPI_NOR_OP_READ_4B, 4U, 1U, 0U, 1U, 0U },
+	{ SPI_NOR_OP_READ_FAST, 3U, 1U, 8U, 1U, 0U },
+	{ SPI_NOR_OP_READ_FAST_4B, 4U, 1U, 8U, 1U, 0U },
+	{ SPI_NOR_OP_READ_1_1_2, 3U, 1U, 8U, 2U, FLASH_MODEL_READ_1_1_2 },
+	{ SPI_NOR_OP_READ_1_1_2_4B, 4U, 1U, 8U, 2U, FLASH_MODEL_READ_1_1_2 },
+	{ SPI_NOR_OP_READ_1_2_2, 3U, 2U, 4U, 2U, FLASH_MODEL_READ_1_2_2 },
+	{ SPI_NOR_OP_READ_1_2_2_4B, 4U, 2U, 4U, 2U, FLASH_MODEL_READ_1_2_2 },
+	{ SPI_NOR_OP_READ_1_1_4, 3U, 1U, 8U, 4U, FLASH_MODEL_READ_1_1_4 },
+	{ SPI_NOR_OP_READ_1_1_4_4B, 4U, 1U, 8U, 4U, FLASH_MODEL_READ_1_1_4 },
+	{ SPI_NOR_OP_READ_1_4_4, 3U, 4U, 10U, 4U, FLASH_MODEL_READ_1_4_4 },
+	{ SPI_NOR_OP_READ_1_4_4_4B, 4U, 4U, 10U, 4U, FLASH_MODEL_READ_1_4_4 },
+	{ SPI_NOR_OP_PAGE_PROGRAM, 3U, 1U, 0U, 1U, 0U },
+	{ SPI_NOR_OP_PAGE_PROGRAM_4B, 4U, 1U, 0U, 1U, 0U },
+	{ SPI_NOR_OP_WRITE_1_1_4, 3U, 1U, 0U, 4U, 0U },
+	{ SPI_NOR_OP_WRITE_1_1_4_4B, 4U, 1U, 0U, 4U, 0U },
+	{ SPI_NOR_OP_ERASE_4SS, 3U, 1U, 0U, 1U, 0U },
+	{ 0x21U, 4U, 1U, 0U, 1U, 0U },		/* 4-KB sector erase, 4-byte address */
+};
+
+static struct flash_model_config flash_cfg;
+static uint8_t *flash;
+static uint8_t sfdp[SFDP_SIZE];
+static uint8_t ear;
+static uint8_t erase_buf[SECTOR_SIZE];
+
+static void sfdp_put32(unsigned int offset, uint32_t val)
+{
+	memcpy(sfdp + offset, &val, sizeof(val));
+}
+
+static void flash_model_build_sfdp(void)
+{
+	memset(sfdp, 0xFF, sizeof(sfdp));
+
+	/* Header: signature, JESD216B, number of parameter headers - 1 */
+	sfdp_put32(0x00U, 0x50444653U);
+	sfdp_put32(0x04U, 0xFF000106U | ((flash_cfg.bait ? 1U : 0U) << 16));
+
+	/* BFPT: 9 DWORDs */
+	sfdp_put32(0x08U, 0x09010600U);
+	sfdp_put32(0x0CU, 0xFF000000U | SFDP_BFPT_OFFSET);
+
+	/* 4BAIT: 2 DWORDs */
+	if (flash_cfg.bait) {
+		sfdp_put32(0x10U, 0x02010084U);
+		sfdp_put32(0x14U, 0xFF000000U | SFDP_4BAIT_OFFSET);
+	}
+
+	/* DWORD 1: read modes, 3- or 4-byte addresses */
+	sfdp_put32(SFDP_BFPT_OFFSET + 0x00U, flash_cfg.read_modes | (1U << 17));
+	/* DWORD 2: density in bits - 1 */
+	sfdp_put32(SFDP_BFPT_OFFSET + 0x04U, (FLASH_MODEL_SIZE * 8U) - 1U);
+	/* DWORD 3: 1-4-4 8 wait states and 2 mode clocks, 1-1-4 8 wait states */
+	sfdp_put32(SFDP_BFPT_OFFSET + 0x08U,
+		   (SPI_NOR_OP_READ_1_1_4 << 24) | (8U << 16) | (SPI_NOR_OP_READ_1_4_4 << 8) | (2U << 5) | 8U);
+	/* DWORD 4: 1-2-2 4 wait states, 1-1-2 8 wait states */
+	sfdp_put32(SFDP_BFPT_OFFSET + 0x0CU,
+		   (SPI_NOR_OP_READ_1_2_2 << 24) | (4U << 16) | (SPI_NOR_OP_READ_1_1_2 << 8) | 8U);
+	/* DWORD 8: erase types 1 (4 KB, 0x20) and 2 (64 KB, 0xD8) */
+	sfdp_put32(SFDP_BFPT_OFFSET + 0x1CU, (0xD8U << 24) | (16U << 16) | (SPI_NOR_OP_ERASE_4SS << 8) | 12U);
+	sfdp_put32(SFDP_BFPT_OFFSET + 0x20U, 0U);
+
+	if (flash_cfg.bait) {
+		/* DWORD 1: every read and program opcode, erase types 1 and 2 */
+		sfdp_put32(SFDP_4BAIT_OFFSET + 0x00U, 0x1FFU | (1U << 9) | (1U << 10));
+		/* DWORD 2: 4-byte erase opcodes */
+		sfdp_put32(SFDP_4BAIT_OFFSET + 0x04U, (0xDCU << 8) | 0x21U);
+	}
+}
+
+void flash_model_setup(const struct flash_model_config *cfg)
+{
+	uint32_t seed = 0x12345678U;
+	size_t i;
+
+	flash_cfg = *cfg;
+	ear = 0U;
+
+	if (flash == NULL) {
+		flash = malloc(FLASH_MODEL_SIZE);
+		if (flash == NULL) {
+			printf("flash model: out of memory\n");
+			exit(1);
+		}
+	}
+
+	/* Random contents, so a read of the wrong address does not match */
+	for (i = 0U; i < FLASH_MODEL_SIZE; i++) {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		flash[i] = (uint8_t)seed;
+	}
+
+	flash_model_build_sfdp();
+}
+
+int plat_get_nor_data(struct nor_device *device)
+{
+	struct spi_mem_op *op = &device->read_op;
+
+	device->size = FLASH_MODEL_SIZE;
+	device->flags |= SPI_NOR_USE_SFDP;
+
+	/* The fastest read the platform wires up, before SFDP is looked at */
+	op->cmd.opcode = SPI_NOR_OP_READ_FAST;
+	op->cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op->addr.nbytes = 3U;
+	op->addr.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op->dummy.nbytes = 1U;
+	op->dummy.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op->data.buswidth = flash_cfg.width;
+	op->data.dir = SPI_MEM_DATA_IN;
+	if (flash_cfg.width == 4U) {
+		op->cmd.opcode = SPI_NOR_OP_READ_1_4_4;
+		op->addr.buswidth = SPI_MEM_BUSWIDTH_4_LINE;
+		op->dummy.nbytes = 5U;
+		op->dummy.buswidth = SPI_MEM_BUSWIDTH_4_LINE;
+	} else if (flash_cfg.width == 2U) {
+		op->cmd.opcode = SPI_NOR_OP_READ_1_2_2;
+		op->addr.buswidth = SPI_MEM_BUSWIDTH_2_LINE;
+		op->dummy.buswidth = SPI_MEM_BUSWIDTH_2_LINE;
+	}
+
+	op = &device->write_op;
+	op->cmd.opcode = (flash_cfg.width == 4U) ? SPI_NOR_OP_WRITE_1_1_4 : SPI_NOR_OP_PAGE_PROGRAM;
+	op->cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op->addr.nbytes = 3U;
+	op->addr.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op->data.buswidth = (flash_cfg.width == 4U) ? SPI_MEM_BUSWIDTH_4_LINE : SPI_MEM_BUSWIDTH_1_LINE;
+	op->data.dir = SPI_MEM_DATA_OUT;
+
+	op = &device->erase_op;
+	op->cmd.opcode = SPI_NOR_OP_ERASE_4SS;
+	op->cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op->addr.nbytes = 3U;
+	op->addr.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op->data.buf = erase_buf;
+
+	device->erase_size = SECTOR_SIZE;
+	device->program_size = PAGE_SIZE;
+
+	return 0;
+}
+
+static const struct flash_model_op *flash_model_find_op(uint8_t opcode)
+{
+	size_t i;
+
+	for (i = 0U; i < sizeof(flash_model_ops) / sizeof(flash_model_ops[0]); i++)
+		if (flash_model_ops[i].opcode == opcode)
+			return &flash_model_ops[i];
+
+	return NULL;
+}
+
+/* Check the op against its protocol and return the flash address it targets */
+static int flash_model_check_op(const struct spi_mem_op *op, uint32_t *addr)
+{
+	const struct flash_model_op *fop = flash_model_find_op(op->cmd.opcode);
+	unsigned int dummy_cycles = 0U;
+
+	if (fop == NULL) {
+		printf("flash model: unknown opcode 0x%02x\n", op->cmd.opcode);
+		return -EIO;
+	}
+
+	if ((fop->read_mode != 0U) && ((flash_cfg.read_modes & fop->read_mode) == 0U)) {
+		printf("flash model: opcode 0x%02x not advertised\n", op->cmd.opcode);
+		return -EIO;
+	}
+
+	if (op->dummy.nbytes != 0U)
+		dummy_cycles = (op->dummy.nbytes * 8U) / op->dummy.buswidth;
+
+	if ((op->cmd.buswidth != 1U) || (op->addr.nbytes != fop->addr_nbytes) ||
+	    (op->addr.buswidth != fop->addr_buswidth) || (dummy_cycles != fop->dummy_cycles) ||
+	    ((dummy_cycles != 0U) && (op->dummy.buswidth != fop->addr_buswidth)) ||
+	    ((op->data.nbytes != 0U) && (op->data.buswidth != fop->data_buswidth))) {
+		printf("flash model: opcode 0x%02x sent as 1-%u-%u, %u address bytes, %u dummy cycles\n",
+		       op->cmd.opcode, op->addr.buswidth, op->data.buswidth, op->addr.nbytes, dummy_cycles);
+		return -EIO;
+	}
+
+	if ((op->addr.buswidth > flash_cfg.width) || (op->data.buswidth > flash_cfg.width)) {
+		printf("flash model: opcode 0x%02x uses more than %u lines\n", op->cmd.opcode, flash_cfg.width);
+		return -EIO;
+	}
+
+	/* 3-byte addresses reach above 16 MB through the extended address register */
+	if (op->addr.nbytes == 4U)
+		*addr = op->addr.val;
+	else
+		*addr = ((uint32_t)ear << 24) | (op->addr.val & 0xFFFFFFU);
+
+	if ((uint64_t)*addr + op->data.nbytes > FLASH_MODEL_SIZE) {
+		printf("flash model: 0x%x bytes at 0x%x past the end\n", op->data.nbytes, *addr);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int spi_mem_exec_op(const struct spi_mem_op *op)
+{
+	uint8_t *buf = op->data.buf;
+	uint32_t addr;
+	unsigned int i;
+	int ret;
+
+	switch (op->cmd.opcode) {
+	case SPI_NOR_OP_READ_SFDP:
+		if ((op->addr.val + op->data.nbytes) > SFDP_SIZE)
+			return -EIO;
+		memcpy(buf, sfdp + op->addr.val, op->data.nbytes);
+		return 0;
+	case SPI_NOR_OP_READ_ID:
+		buf[0] = 0x20U;
+		return 0;
+	case SPI_NOR_OP_READ_SR:
+		buf[0] = 0U;
+		return 0;
+	case SPI_NOR_OP_WREN:
+	case SPI_NOR_OP_WRDIS:
+		return 0;
+	case SPINOR_OP_WREAR:
+		ear = buf[0];
+		return 0;
+	case SPINOR_OP_RDEAR:
+		buf[0] = ear;
+		return 0;
+	default:
+		break;
+	}
+
+	ret = flash_model_check_op(op, &addr);
+	if (ret != 0)
+		return ret;
+
+	switch (op->cmd.opcode) {
+	case SPI_NOR_OP_ERASE_4SS:
+	case 0x21U:
+		memset(flash + (addr & ~(SECTOR_SIZE - 1U)), 0xFF, SECTOR_SIZE);
+		return 0;
+	case SPI_NOR_OP_PAGE_PROGRAM:
+	case SPI_NOR_OP_PAGE_PROGRAM_4B:
+	case SPI_NOR_OP_WRITE_1_1_4:
+	case SPI_NOR_OP_WRITE_1_1_4_4B:
+		/* Programming only clears bits, and wraps within the page */
+		for (i = 0U; i < op->data.nbytes; i++)
+			flash[(addr & ~(PAGE_SIZE - 1U)) | ((addr + i) & (PAGE_SIZE - 1U))] &= buf[i];
+		return 0;
+	default:
+		memcpy(buf, flash + addr, op->data.nbytes);
+		return 0;
+	}
+}
+
+int spi_mem_poll_status(const struct spi_mem_op *op, uint8_t mask,
+			uint8_t match, unsigned int timeout_us)
+{
+	/* Every program and erase completes at once */
+	return 0;
+}
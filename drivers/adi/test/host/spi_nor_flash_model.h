@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SPI_NOR_FLASH_MODEL_H
+#define SPI_NOR_FLASH_MODEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FLASH_MODEL_SIZE	(32U << 20)	/* Two 16 MB banks */
+
+/* JESD216 BFPT DWORD 1 fast read support bits */
+#define FLASH_MODEL_READ_1_1_2	(1U << 16)
+#define FLASH_MODEL_READ_1_2_2	(1U << 20)
+#define FLASH_MODEL_READ_1_4_4	(1U << 21)
+#define FLASH_MODEL_READ_1_1_4	(1U << 22)
+
+struct flash_model_config {
+	uint32_t read_modes;		/* FLASH_MODEL_READ_* the flash advertises */
+	bool bait;			/* SFDP has a 4-byte address instruction table */
+	unsigned int width;		/* Data lines the platform wired up: 1, 2 or 4 */
+};
+
+/*
+ * Reset the flash to random contents and build its SFDP tables. The platform
+ * ops handed to the driver by plat_get_nor_data() follow cfg->width.
+ */
+void flash_model_setup(const struct flash_model_config *cfg);
+
+#endif /* SPI_NOR_FLASH_MODEL_H */
@@ -32,6 +32,9 @@
 
 #pragma weak plat_set_nv_ctr2
 
+/* Number of times a parent was found already authenticated, so not reloaded and verified again */
+static unsigned int auth_parent_cache_hits;
+
 static int cmp_auth_param_type_desc(const auth_param_type_desc_t *a,
 		const auth_param_type_desc_t *b)
 {
@@ -351,6 +354,7 @@ int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id)
 
 	/* Check if the parent has already been authenticated */
 	if (auth_img_flags[img_desc->parent->img_id] & IMG_FLAG_AUTHENTICATED) {
+		auth_parent_cache_hits++;
 		*parent_id = 0;
 		return 1;
 	}
@@ -359,6 +363,15 @@ int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id)
 	return 0;
 }
 
+/*
+ * Return how many parent certificates were not reloaded and verified again
+ * because they had already been authenticated in this boot stage
+ */
+unsigned int auth_mod_get_parent_cache_hits(void)
+{
+	return auth_parent_cache_hits;
+}
+
 /*
  * Initialize the different modules in the authentication framework
  */
@@ -187,3 +187,51 @@ int crypto_mod_auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
 					    key_len, key_flags, iv, iv_len, tag,
 					    tag_len);
 }
+
+/*
+ * Hash a buffer while it is loaded
+ *
+ * Start with the final location and size of the data, then pass each chunk
+ * in order as soon as it has been written. Once finished, verify_hash() and
+ * calc_hash() on the same buffer use the digest computed on the way instead
+ * of reading the data again.
+ *
+ * Returns CRYPTO_ERR_HASH if the library cannot hash while loading, the
+ * caller then simply loads the data without it.
+ */
+int crypto_mod_hash_stream_start(void *data_ptr, unsigned int data_len)
+{
+	assert(data_ptr != NULL);
+	assert(data_len != 0);
+
+	if (crypto_lib_desc.hash_stream_start == NULL) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return crypto_lib_desc.hash_stream_start(data_ptr, data_len);
+}
+
+int crypto_mod_hash_stream_update(void *data_ptr, unsigned int data_len)
+{
+	assert(crypto_lib_desc.hash_stream_update != NULL);
+
+	return crypto_lib_desc.hash_stream_update(data_ptr, data_len);
+}
+
+int crypto_mod_hash_stream_finish(void)
+{
+	assert(crypto_lib_desc.hash_stream_finish != NULL);
+
+	return crypto_lib_desc.hash_stream_finish();
+}
+
+/*
+ * Drop the digest kept by the last stream, so that it cannot be matched
+ * against a later buffer that happens to have the same location and size
+ */
+void crypto_mod_hash_stream_discard(void)
+{
+	if (crypto_lib_desc.hash_stream_discard != NULL) {
+		(void)crypto_lib_desc.hash_stream_discard();
+	}
+}
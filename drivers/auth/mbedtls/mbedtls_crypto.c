@@ -5,7 +5,9 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 /* mbed TLS headers */
@@ -54,6 +56,124 @@ CASSERT(CRYPTO_MD_MAX_SIZE >= MBEDTLS_MD_MAX_SIZE,
  * }
  */
 
+/*
+ * Hash computed while the image was being loaded, see hash_stream_start().
+ * Only one stream exists at a time, starting a new one drops the previous
+ * digest.
+ */
+#if TF_MBEDTLS_HASH_ALG_ID == TF_MBEDTLS_SHA384
+#define STREAM_MD_TYPE		MBEDTLS_MD_SHA384
+#elif TF_MBEDTLS_HASH_ALG_ID == TF_MBEDTLS_SHA512
+#define STREAM_MD_TYPE		MBEDTLS_MD_SHA512
+#else
+#define STREAM_MD_TYPE		MBEDTLS_MD_SHA256
+#endif
+
+static struct {
+	mbedtls_md_context_t ctx;
+	uintptr_t base;
+	size_t len;
+	size_t done;
+	bool active;
+	bool valid;
+	unsigned char digest[MBEDTLS_MD_MAX_SIZE];
+} stream;
+
+static int hash_stream_start(void *data_ptr, unsigned int data_len)
+{
+	const mbedtls_md_info_t *md_info;
+
+	if (stream.active) {
+		mbedtls_md_free(&stream.ctx);
+	}
+	stream.active = false;
+	stream.valid = false;
+
+	md_info = mbedtls_md_info_from_type(STREAM_MD_TYPE);
+	if (md_info == NULL) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	mbedtls_md_init(&stream.ctx);
+	if ((mbedtls_md_setup(&stream.ctx, md_info, 0) != 0) ||
+	    (mbedtls_md_starts(&stream.ctx) != 0)) {
+		mbedtls_md_free(&stream.ctx);
+		return CRYPTO_ERR_HASH;
+	}
+
+	stream.base = (uintptr_t)data_ptr;
+	stream.len = data_len;
+	stream.done = 0U;
+	stream.active = true;
+
+	return CRYPTO_SUCCESS;
+}
+
+/* Chunks must follow each other, anything else abandons the stream */
+static int hash_stream_update(void *data_ptr, unsigned int data_len)
+{
+	if (!stream.active) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	if (((uintptr_t)data_ptr != (stream.base + stream.done)) ||
+	    (data_len > (stream.len - stream.done)) ||
+	    (mbedtls_md_update(&stream.ctx, data_ptr, data_len) != 0)) {
+		mbedtls_md_free(&stream.ctx);
+		stream.active = false;
+		return CRYPTO_ERR_HASH;
+	}
+
+	stream.done += data_len;
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_stream_finish(void)
+{
+	int rc = CRYPTO_ERR_HASH;
+
+	if (!stream.active) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	if ((stream.done == stream.len) &&
+	    (mbedtls_md_finish(&stream.ctx, stream.digest) == 0)) {
+		stream.valid = true;
+		rc = CRYPTO_SUCCESS;
+	}
+
+	mbedtls_md_free(&stream.ctx);
+	stream.active = false;
+
+	return rc;
+}
+
+/* Drop the digest once its image has been authenticated and measured */
+static int hash_stream_discard(void)
+{
+	if (stream.active) {
+		mbedtls_md_free(&stream.ctx);
+	}
+	stream.active = false;
+	stream.valid = false;
+	memset(stream.digest, 0, sizeof(stream.digest));
+
+	return CRYPTO_SUCCESS;
+}
+
+/* Return the streamed digest of [data_ptr, data_ptr + data_len) if there is one for md_type */
+static const unsigned char *stream_digest(mbedtls_md_type_t md_type,
+					  void *data_ptr, unsigned int data_len)
+{
+	if (!stream.valid || (md_type != STREAM_MD_TYPE) ||
+	    ((uintptr_t)data_ptr != stream.base) || (data_len != stream.len)) {
+		return NULL;
+	}
+
+	return stream.digest;
+}
+
 /*
  * Initialize the library and export the descriptor
  */
@@ -167,6 +287,7 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	mbedtls_md_type_t md_alg;
 	const mbedtls_md_info_t *md_info;
 	unsigned char *p, *end, *hash;
+	const unsigned char *streamed;
 	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
 	size_t len;
 	int rc;
@@ -211,11 +332,16 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	}
 	hash = p;
 
-	/* Calculate the hash of the data */
-	p = (unsigned char *)data_ptr;
-	rc = mbedtls_md(md_info, p, data_len, data_hash);
-	if (rc != 0) {
-		return CRYPTO_ERR_HASH;
+	/* Calculate the hash of the data, unless it was hashed while loading */
+	streamed = stream_digest(md_alg, data_ptr, data_len);
+	if (streamed != NULL) {
+		memcpy(data_hash, streamed, mbedtls_md_get_size(md_info));
+	} else {
+		p = (unsigned char *)data_ptr;
+		rc = mbedtls_md(md_info, p, data_len, data_hash);
+		if (rc != 0) {
+			return CRYPTO_ERR_HASH;
+		}
 	}
 
 	/* Compare values */
@@ -260,12 +386,20 @@ static int calc_hash(enum crypto_md_algo md_algo, void *data_ptr,
 		     unsigned char output[CRYPTO_MD_MAX_SIZE])
 {
 	const mbedtls_md_info_t *md_info;
+	const unsigned char *streamed;
 
 	md_info = mbedtls_md_info_from_type(md_type(md_algo));
 	if (md_info == NULL) {
 		return CRYPTO_ERR_HASH;
 	}
 
+	/* Reuse the digest computed while loading, if any */
+	streamed = stream_digest(md_type(md_algo), data_ptr, data_len);
+	if (streamed != NULL) {
+		memcpy(output, streamed, mbedtls_md_get_size(md_info));
+		return CRYPTO_SUCCESS;
+	}
+
 	/*
 	 * Calculate the hash of the data, it is safe to pass the
 	 * 'output' hash buffer pointer considering its size is always
@@ -395,20 +529,30 @@ static int auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
  */
 #if CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
 #if TF_MBEDTLS_USE_AES_GCM
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
-		    auth_decrypt, NULL);
+REGISTER_CRYPTO_LIB_HASH_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+				calc_hash, auth_decrypt, NULL, hash_stream_start,
+				hash_stream_update, hash_stream_finish,
+				hash_stream_discard);
 #else
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
-		    NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+				calc_hash, NULL, NULL, hash_stream_start,
+				hash_stream_update, hash_stream_finish,
+				hash_stream_discard);
 #endif
 #elif CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY
 #if TF_MBEDTLS_USE_AES_GCM
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL,
-		    auth_decrypt, NULL);
+REGISTER_CRYPTO_LIB_HASH_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+				NULL, auth_decrypt, NULL, hash_stream_start,
+				hash_stream_update, hash_stream_finish,
+				hash_stream_discard);
 #else
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL,
-		    NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+				NULL, NULL, NULL, hash_stream_start,
+				hash_stream_update, hash_stream_finish,
+				hash_stream_discard);
 #endif
 #elif CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY
-REGISTER_CRYPTO_LIB(LIB_NAME, init, NULL, NULL, calc_hash, NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_STREAM(LIB_NAME, init, NULL, NULL, calc_hash, NULL,
+				NULL, hash_stream_start, hash_stream_update,
+				hash_stream_finish, hash_stream_discard);
 #endif /* CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC */
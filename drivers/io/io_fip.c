@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -63,6 +64,27 @@ static uintptr_t backend_image_spec;
 static fip_dev_state_t state_pool[MAX_FIP_DEVICES];
 static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
 
+#ifdef FIP_TOC_INDEX_MAX_ENTRIES
+/*
+ * Optional index of the ToC of the FIP behind the backend, sorted by UUID.
+ * It is filled by fip_dev_init() with a single read of the ToC, after which
+ * files are opened without accessing the backend, and later fip_dev_init()
+ * calls on the same backend return straight away. The index is only used
+ * while the backend handle and spec are the ones it was built from, so the
+ * backend spec must be an io_block_spec_t, whose offset and length are kept
+ * to notice a spec updated in place (e.g. when switching to another FIP
+ * slot). The FIP region must be at least as large as the index (the read is
+ * not clamped to the ToC). A ToC with more entries than the index is
+ * searched the usual way.
+ */
+static fip_toc_entry_t toc_index[FIP_TOC_INDEX_MAX_ENTRIES + 1]; /* + terminator */
+static unsigned int toc_index_count;
+static bool toc_index_valid;
+static uintptr_t toc_index_dev_handle;
+static uintptr_t toc_index_image_spec;
+static io_block_spec_t toc_index_block_spec;
+#endif
+
 /* Track number of allocated fip devices */
 static unsigned int fip_dev_count;
 
@@ -85,6 +107,96 @@ static inline int compare_uuids(const uuid_t *uuid1, const uuid_t *uuid2)
 }
 
 
+#ifdef FIP_TOC_INDEX_MAX_ENTRIES
+/* Read the ToC following the header into toc_index and sort it by UUID */
+static void build_toc_index(uintptr_t backend_handle)
+{
+	static const uuid_t uuid_null = { {0} }; /* Double braces for clang */
+	fip_toc_entry_t entry;
+	size_t bytes_read;
+	unsigned int count;
+	unsigned int num;
+	unsigned int i;
+	int result;
+
+	toc_index_valid = false;
+
+	result = io_read(backend_handle, (uintptr_t)toc_index,
+			 sizeof(toc_index), &bytes_read);
+	if (result != 0) {
+		return;
+	}
+
+	num = (unsigned int)(bytes_read / sizeof(fip_toc_entry_t));
+	for (count = 0U; count < num; count++) {
+		if (compare_uuids(&toc_index[count].uuid, &uuid_null) == 0) {
+			break;
+		}
+	}
+
+	/* No terminator, the ToC does not fit */
+	if (count == num) {
+		VERBOSE("FIP ToC larger than the index, not indexed\n");
+		return;
+	}
+
+	/* Insertion sort, the ToC only has a few dozen entries */
+	for (i = 1U; i < count; i++) {
+		unsigned int j = i;
+
+		entry = toc_index[i];
+		while ((j > 0U) &&
+		       (compare_uuids(&toc_index[j - 1U].uuid, &entry.uuid) > 0)) {
+			toc_index[j] = toc_index[j - 1U];
+			j--;
+		}
+		toc_index[j] = entry;
+	}
+
+	toc_index_count = count;
+	toc_index_dev_handle = backend_dev_handle;
+	toc_index_image_spec = backend_image_spec;
+	toc_index_block_spec = *(const io_block_spec_t *)backend_image_spec;
+	toc_index_valid = true;
+}
+
+/* Check that toc_index describes the FIP currently behind the backend */
+static bool toc_index_matches(void)
+{
+	const io_block_spec_t *spec = (const io_block_spec_t *)backend_image_spec;
+
+	return toc_index_valid &&
+	       (toc_index_dev_handle == backend_dev_handle) &&
+	       (toc_index_image_spec == backend_image_spec) &&
+	       (spec->offset == toc_index_block_spec.offset) &&
+	       (spec->length == toc_index_block_spec.length);
+}
+
+/* Look a UUID up in toc_index */
+static const fip_toc_entry_t *find_toc_index(const uuid_t *uuid)
+{
+	unsigned int lo = 0U;
+	unsigned int hi = toc_index_count;
+	unsigned int mid;
+	int cmp;
+
+	while (lo < hi) {
+		mid = lo + ((hi - lo) / 2U);
+		cmp = compare_uuids(&toc_index[mid].uuid, uuid);
+		if (cmp == 0) {
+			return &toc_index[mid];
+		}
+		if (cmp < 0) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return NULL;
+}
+#endif /* FIP_TOC_INDEX_MAX_ENTRIES */
+
 static inline int is_valid_header(fip_toc_header_t *header)
 {
 	if ((header->name == TOC_HEADER_NAME) && (header->serial_number != 0)) {
@@ -236,6 +348,13 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 		goto fip_dev_init_exit;
 	}
 
+#ifdef FIP_TOC_INDEX_MAX_ENTRIES
+	/* Already checked and indexed */
+	if (toc_index_matches()) {
+		goto fip_dev_init_exit;
+	}
+#endif
+
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
@@ -258,6 +377,9 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 			 * bits [32-47] in fip header.
 			 */
 			state->plat_toc_flag = (header.flags >> 32) & 0xffff;
+#ifdef FIP_TOC_INDEX_MAX_ENTRIES
+			build_toc_index(backend_handle);
+#endif
 		}
 	}
 
@@ -275,6 +397,9 @@ static int fip_dev_close(io_dev_info_t *dev_info)
 	/* Clear the backend. */
 	backend_dev_handle = (uintptr_t)NULL;
 	backend_image_spec = (uintptr_t)NULL;
+#ifdef FIP_TOC_INDEX_MAX_ENTRIES
+	toc_index_valid = false;
+#endif
 
 	return free_dev_info(dev_info);
 }
@@ -305,6 +430,22 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 		return -ENFILE;
 	}
 
+#ifdef FIP_TOC_INDEX_MAX_ENTRIES
+	/* Anything else than the indexed FIP takes the linear scan below */
+	if (toc_index_matches()) {
+		const fip_toc_entry_t *entry = find_toc_index(&uuid_spec->uuid);
+
+		if (entry == NULL) {
+			return -ENOENT;
+		}
+
+		current_fip_file.entry = *entry;
+		current_fip_file.file_pos = 0;
+		entity->info = (uintptr_t)&current_fip_file;
+		return 0;
+	}
+#endif
+
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
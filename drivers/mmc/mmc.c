@@ -43,7 +43,12 @@ static const unsigned char sd_tran_speed_base[16] = {
 
 static bool is_cmd23_enabled(void)
 {
-	return ((mmc_flags & MMC_FLAG_CMD23) != 0U);
+	return ((mmc_flags & (MMC_FLAG_CMD23 | MMC_FLAG_AUTO_CMD23)) != 0U);
+}
+
+static bool is_auto_cmd23_enabled(void)
+{
+	return ((mmc_flags & MMC_FLAG_AUTO_CMD23) != 0U);
 }
 
 static bool is_sd_cmd6_enabled(void)
@@ -51,6 +56,16 @@ static bool is_sd_cmd6_enabled(void)
 	return ((mmc_flags & MMC_FLAG_SD_CMD6) != 0U);
 }
 
+static bool is_hs200_enabled(void)
+{
+	return ((mmc_flags & (MMC_FLAG_HS200 | MMC_FLAG_HS400)) != 0U);
+}
+
+static bool is_hs400_enabled(void)
+{
+	return ((mmc_flags & MMC_FLAG_HS400) != 0U);
+}
+
 static int mmc_send_cmd(unsigned int idx, unsigned int arg,
 			unsigned int r_type, unsigned int *r_data)
 {
@@ -253,6 +268,93 @@ static int mmc_set_ios(unsigned int clk, unsigned int bus_width)
 	return ops->set_ios(clk, width);
 }
 
+/* Switch card and host to a new bus timing, then apply the bus clock */
+static int mmc_set_timing(unsigned int timing, unsigned int clk,
+			  unsigned int bus_width)
+{
+	int ret;
+
+	ret = mmc_set_ext_csd(CMD_EXTCSD_HS_TIMING, timing);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = ops->set_timing(timing);
+	if (ret != 0) {
+		return ret;
+	}
+
+	return ops->set_ios(clk, bus_width);
+}
+
+static int mmc_select_hs400(unsigned int clk)
+{
+	int ret;
+
+	/* HS400 is entered from tuned HS200 through HS timing */
+	mmc_dev_info->max_bus_freq = MMC_HS_MAX_BUS_FREQ;
+	ret = mmc_set_timing(MMC_TIMING_HS, clk, MMC_BUS_WIDTH_8);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = mmc_set_ext_csd(CMD_EXTCSD_BUS_WIDTH, MMC_BUS_WIDTH_DDR_8);
+	if (ret != 0) {
+		return ret;
+	}
+
+	mmc_dev_info->max_bus_freq = MMC_HS200_MAX_BUS_FREQ;
+
+	return mmc_set_timing(MMC_TIMING_HS400, clk, MMC_BUS_WIDTH_DDR_8);
+}
+
+static int mmc_select_hs200(unsigned int clk, unsigned int bus_width)
+{
+	unsigned char dev_type = mmc_ext_csd[CMD_EXTCSD_DEVICE_TYPE];
+	unsigned int legacy_freq = mmc_dev_info->max_bus_freq;
+	int ret;
+
+	if (!is_hs200_enabled() || (ops->set_timing == NULL) ||
+	    (ops->execute_tuning == NULL) ||
+	    (bus_width == MMC_BUS_WIDTH_1) ||
+	    ((dev_type & EXT_CSD_DEVICE_TYPE_HS200_1_8V) == 0U)) {
+		/* Keep the current timing */
+		return 0;
+	}
+
+	mmc_dev_info->max_bus_freq = MMC_HS200_MAX_BUS_FREQ;
+	ret = mmc_set_timing(MMC_TIMING_HS200, clk, bus_width);
+	if (ret == 0) {
+		ret = ops->execute_tuning();
+	}
+
+	if (ret != 0) {
+		/*
+		 * Tuning failed, fall back to legacy timing. The host goes back
+		 * to legacy timing and clock first, as CMD6 cannot be relied on
+		 * at an untuned HS200 clock.
+		 */
+		WARN("MMC: HS200 not usable (%d), keep legacy timing\n", ret);
+		mmc_dev_info->max_bus_freq = legacy_freq;
+		ret = ops->set_timing(MMC_TIMING_LEGACY);
+		if (ret == 0) {
+			ret = ops->set_ios(clk, bus_width);
+		}
+		if (ret == 0) {
+			ret = mmc_set_ext_csd(CMD_EXTCSD_HS_TIMING, MMC_TIMING_LEGACY);
+		}
+
+		return ret;
+	}
+
+	if (is_hs400_enabled() && (bus_width == MMC_BUS_WIDTH_8) &&
+	    ((dev_type & EXT_CSD_DEVICE_TYPE_HS400_1_8V) != 0U)) {
+		return mmc_select_hs400(clk);
+	}
+
+	return 0;
+}
+
 static int mmc_fill_device_info(void)
 {
 	unsigned long long c_size;
@@ -557,6 +659,10 @@ static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 		return ret;
 	}
 
+	if (mmc_dev_info->mmc_dev_type == MMC_IS_EMMC) {
+		return mmc_select_hs200(clk, bus_width);
+	}
+
 	if (is_sd_cmd6_enabled() &&
 	    (mmc_dev_info->mmc_dev_type == MMC_IS_SD_HC)) {
 		/* Try to switch to High Speed Mode */
@@ -603,11 +709,13 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 	}
 
 	if (is_cmd23_enabled()) {
-		/* Set block count */
-		ret = mmc_send_cmd(MMC_CMD(23), size / MMC_BLOCK_SIZE,
-				   MMC_RESPONSE_R1, NULL);
-		if (ret != 0) {
-			return 0;
+		/* Set block count, unless the host sends it automatically */
+		if (!is_auto_cmd23_enabled()) {
+			ret = mmc_send_cmd(MMC_CMD(23), size / MMC_BLOCK_SIZE,
+					   MMC_RESPONSE_R1, NULL);
+			if (ret != 0) {
+				return 0;
+			}
 		}
 
 		cmd_idx = MMC_CMD(18);
@@ -671,11 +779,13 @@ size_t mmc_write_blocks(int lba, const uintptr_t buf, size_t size)
 	}
 
 	if (is_cmd23_enabled()) {
-		/* Set block count */
-		ret = mmc_send_cmd(MMC_CMD(23), size / MMC_BLOCK_SIZE,
-				   MMC_RESPONSE_R1, NULL);
-		if (ret != 0) {
-			return 0;
+		/* Set block count, unless the host sends it automatically */
+		if (!is_auto_cmd23_enabled()) {
+			ret = mmc_send_cmd(MMC_CMD(23), size / MMC_BLOCK_SIZE,
+					   MMC_RESPONSE_R1, NULL);
+			if (ret != 0) {
+				return 0;
+			}
 		}
 
 		cmd_idx = MMC_CMD(25);
@@ -6,12 +6,15 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 
 #include <common/debug.h>
 #include <drivers/delay_timer.h>
 #include <drivers/spi_nor.h>
 #include <lib/utils.h>
+#include <lib/utils_def.h>
 
 #define SR_WIP			BIT(0)	/* Write in progress */
 #define CR_QUAD_EN_SPAN		BIT(1)	/* Spansion Quad I/O */
@@ -28,6 +31,24 @@
 
 #define SPI_READY_TIMEOUT_US	40000U
 
+/* SFDP (JESD216) header and parameter tables */
+#define SFDP_SIGNATURE		0x50444653U	/* "SFDP" */
+#define SFDP_HEADER_SIZE	8U
+#define SFDP_PARAM_HEADER_SIZE	8U
+#define SFDP_MAX_PARAM_HEADERS	16U
+#define SFDP_BFPT_ID		0xFF00U		/* Basic Flash Parameter Table */
+#define SFDP_4BAIT_ID		0xFF84U		/* 4-byte Address Instruction Table */
+#define SFDP_BFPT_DWORDS	9U
+#define SFDP_4BAIT_DWORDS	2U
+
+#define BFPT_DW1_READ_1_1_2	BIT(16)
+#define BFPT_DW1_ADDR_BYTES	GENMASK(18, 17)	/* 0: 3-byte only */
+#define BFPT_DW1_READ_1_2_2	BIT(20)
+#define BFPT_DW1_READ_1_4_4	BIT(21)
+#define BFPT_DW1_READ_1_1_4	BIT(22)
+#define BFPT_DW_ERASE_TYPES	7U		/* DWORDs 8 and 9, two erase types each */
+#define BFPT_4BAIT_ERASE_SHIFT	9U		/* 4BAIT DWORD 1 bits 9-12, erase types 1-4 */
+
 static struct nor_device nor_dev;
 
 #pragma weak plat_get_nor_data
@@ -115,7 +136,24 @@ static int spi_nor_ready(void)
 static int spi_nor_wait_ready(void)
 {
 	int ret;
-	uint64_t timeout = timeout_init_us(SPI_READY_TIMEOUT_US);
+	uint64_t timeout;
+	struct spi_mem_op op;
+	uint8_t sr;
+
+	/* Without FSR, only WIP matters: poll it in a single bus transaction */
+	if ((nor_dev.flags & SPI_NOR_USE_FSR) == 0U) {
+		zeromem(&op, sizeof(struct spi_mem_op));
+		op.cmd.opcode = SPI_NOR_OP_READ_SR;
+		op.cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+		op.data.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+		op.data.dir = SPI_MEM_DATA_IN;
+		op.data.nbytes = 1U;
+		op.data.buf = &sr;
+
+		return spi_mem_poll_status(&op, SR_WIP, 0U, SPI_READY_TIMEOUT_US);
+	}
+
+	timeout = timeout_init_us(SPI_READY_TIMEOUT_US);
 
 	while (!timeout_elapsed(timeout)) {
 		ret = spi_nor_ready();
@@ -280,6 +318,259 @@ static int spi_nor_read_bar(void)
 	return 0;
 }
 
+/*
+ * SFDP fast read modes, fastest first. 4-4-4 and DTR modes are not listed:
+ * 4-4-4 needs every command in QPI mode and spi_mem_op has no DTR phase.
+ */
+static const struct spi_nor_sfdp_read {
+	uint32_t support;	/* BFPT DWORD 1 support bit */
+	uint8_t dword;		/* BFPT DWORD holding wait states, mode clocks, opcode */
+	uint8_t shift;
+	uint8_t addr_buswidth;
+	uint8_t data_buswidth;
+} sfdp_reads[] = {
+	{ BFPT_DW1_READ_1_4_4, 2U, 0U, SPI_MEM_BUSWIDTH_4_LINE, SPI_MEM_BUSWIDTH_4_LINE },
+	{ BFPT_DW1_READ_1_1_4, 2U, 16U, SPI_MEM_BUSWIDTH_1_LINE, SPI_MEM_BUSWIDTH_4_LINE },
+	{ BFPT_DW1_READ_1_2_2, 3U, 16U, SPI_MEM_BUSWIDTH_2_LINE, SPI_MEM_BUSWIDTH_2_LINE },
+	{ BFPT_DW1_READ_1_1_2, 3U, 0U, SPI_MEM_BUSWIDTH_1_LINE, SPI_MEM_BUSWIDTH_2_LINE },
+};
+
+/* 3-byte address opcodes and their 4BAIT DWORD 1 support bit */
+static const struct spi_nor_4b_opcode {
+	uint8_t opcode;
+	uint8_t opcode_4b;
+	uint8_t support_bit;
+} opcodes_4b[] = {
+	{ SPI_NOR_OP_READ, SPI_NOR_OP_READ_4B, 0U },
+	{ SPI_NOR_OP_READ_FAST, SPI_NOR_OP_READ_FAST_4B, 1U },
+	{ SPI_NOR_OP_READ_1_1_2, SPI_NOR_OP_READ_1_1_2_4B, 2U },
+	{ SPI_NOR_OP_READ_1_2_2, SPI_NOR_OP_READ_1_2_2_4B, 3U },
+	{ SPI_NOR_OP_READ_1_1_4, SPI_NOR_OP_READ_1_1_4_4B, 4U },
+	{ SPI_NOR_OP_READ_1_4_4, SPI_NOR_OP_READ_1_4_4_4B, 5U },
+	{ SPI_NOR_OP_PAGE_PROGRAM, SPI_NOR_OP_PAGE_PROGRAM_4B, 6U },
+	{ SPI_NOR_OP_WRITE_1_1_4, SPI_NOR_OP_WRITE_1_1_4_4B, 7U },
+	{ SPI_NOR_OP_WRITE_1_4_4, SPI_NOR_OP_WRITE_1_4_4_4B, 8U },
+};
+
+/* Reads are kept short so the controller does not need DMA for them */
+static int spi_nor_read_sfdp(uint32_t offset, void *buf, size_t len)
+{
+	struct spi_mem_op op;
+
+	zeromem(&op, sizeof(struct spi_mem_op));
+	op.cmd.opcode = SPI_NOR_OP_READ_SFDP;
+	op.cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.addr.nbytes = 3U;
+	op.addr.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.addr.val = offset;
+	op.dummy.nbytes = 1U;
+	op.dummy.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.data.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.data.dir = SPI_MEM_DATA_IN;
+	op.data.nbytes = len;
+	op.data.buf = buf;
+
+	return spi_mem_exec_op(&op);
+}
+
+/*
+ * Switch the read op to the fastest mode the flash advertises, without using
+ * more data lines than the platform read op does.
+ */
+static void spi_nor_sfdp_select_read(const uint32_t *bfpt)
+{
+	const struct spi_nor_sfdp_read *mode;
+	struct spi_mem_op *op = &nor_dev.read_op;
+	uint32_t settings;
+	uint32_t cycles;
+	uint8_t opcode;
+	unsigned int i;
+
+	for (i = 0U; i < ARRAY_SIZE(sfdp_reads); i++) {
+		mode = &sfdp_reads[i];
+
+		if (((bfpt[0] & mode->support) == 0U) ||
+		    (mode->data_buswidth > op->data.buswidth)) {
+			continue;
+		}
+
+		/* Wait states [4:0], mode clocks [7:5], opcode [15:8] */
+		settings = bfpt[mode->dword] >> mode->shift;
+		opcode = (settings >> 8) & 0xFFU;
+		cycles = (settings & 0x1FU) + ((settings >> 5) & 0x7U);
+
+		/* Dummy phase is sent in whole bytes */
+		if ((opcode == 0U) || (((cycles * mode->addr_buswidth) % 8U) != 0U)) {
+			continue;
+		}
+
+		op->cmd.opcode = opcode;
+		op->cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+		op->addr.buswidth = mode->addr_buswidth;
+		op->dummy.nbytes = (cycles * mode->addr_buswidth) / 8U;
+		op->dummy.buswidth = mode->addr_buswidth;
+		op->data.buswidth = mode->data_buswidth;
+
+		INFO("SPI NOR: SFDP read 1-%u-%u, opcode 0x%x, %u dummy cycles\n",
+		     mode->addr_buswidth, mode->data_buswidth, opcode, cycles);
+		return;
+	}
+}
+
+static int spi_nor_opcode_4b(uint8_t opcode, uint32_t bait_dw1, uint8_t *opcode_4b)
+{
+	unsigned int i;
+
+	for (i = 0U; i < ARRAY_SIZE(opcodes_4b); i++) {
+		if ((opcodes_4b[i].opcode == opcode) &&
+		    ((bait_dw1 & BIT(opcodes_4b[i].support_bit)) != 0U)) {
+			*opcode_4b = opcodes_4b[i].opcode_4b;
+			return 0;
+		}
+	}
+
+	return -ENOTSUP;
+}
+
+/* Erase opcodes come from the BFPT erase types, their 4-byte forms from 4BAIT DWORD 2 */
+static int spi_nor_erase_opcode_4b(uint8_t opcode, const uint32_t *bfpt,
+				   const uint32_t *bait, uint8_t *opcode_4b)
+{
+	uint32_t type;
+	unsigned int i;
+
+	for (i = 0U; i < 4U; i++) {
+		type = (bfpt[BFPT_DW_ERASE_TYPES + (i / 2U)] >> ((i % 2U) * 16U)) & 0xFFFFU;
+
+		/* Size exponent [7:0], zero if unused, opcode [15:8] */
+		if (((type & 0xFFU) == 0U) || ((type >> 8) != opcode)) {
+			continue;
+		}
+
+		*opcode_4b = (bait[1] >> (i * 8U)) & 0xFFU;
+		if (((bait[0] & BIT(BFPT_4BAIT_ERASE_SHIFT + i)) == 0U) ||
+		    (*opcode_4b == 0U) || (*opcode_4b == 0xFFU)) {
+			return -ENOTSUP;
+		}
+
+		return 0;
+	}
+
+	return -ENOTSUP;
+}
+
+/*
+ * Replace bank address register switching with 4-byte address opcodes, if the
+ * flash has them for every operation in use.
+ */
+static void spi_nor_sfdp_use_4b(const uint32_t *bfpt, const uint32_t *bait)
+{
+	uint8_t read_4b;
+	uint8_t write_4b = 0U;
+	uint8_t erase_4b = 0U;
+
+	if ((bfpt[0] & BFPT_DW1_ADDR_BYTES) == 0U) {
+		return;
+	}
+
+	if (spi_nor_opcode_4b(nor_dev.read_op.cmd.opcode, bait[0], &read_4b) != 0) {
+		return;
+	}
+
+	if ((nor_dev.write_op.cmd.opcode != 0U) &&
+	    (spi_nor_opcode_4b(nor_dev.write_op.cmd.opcode, bait[0], &write_4b) != 0)) {
+		return;
+	}
+
+	if ((nor_dev.erase_op.cmd.opcode != 0U) &&
+	    (spi_nor_erase_opcode_4b(nor_dev.erase_op.cmd.opcode, bfpt, bait, &erase_4b) != 0)) {
+		return;
+	}
+
+	nor_dev.read_op.cmd.opcode = read_4b;
+	nor_dev.read_op.addr.nbytes = 4U;
+
+	if (write_4b != 0U) {
+		nor_dev.write_op.cmd.opcode = write_4b;
+		nor_dev.write_op.addr.nbytes = 4U;
+	}
+
+	if (erase_4b != 0U) {
+		nor_dev.erase_op.cmd.opcode = erase_4b;
+		nor_dev.erase_op.addr.nbytes = 4U;
+	}
+
+	nor_dev.flags &= ~SPI_NOR_USE_BANK;
+
+	INFO("SPI NOR: SFDP 4-byte address opcodes\n");
+}
+
+/* Tune the platform ops from the flash SFDP tables */
+static int spi_nor_sfdp_setup(void)
+{
+	uint32_t header[SFDP_HEADER_SIZE / sizeof(uint32_t)];
+	uint32_t param[SFDP_PARAM_HEADER_SIZE / sizeof(uint32_t)];
+	uint32_t bfpt[SFDP_BFPT_DWORDS];
+	uint32_t bait[SFDP_4BAIT_DWORDS];
+	uint32_t nph;
+	uint32_t id;
+	uint32_t len;
+	uint32_t ptp;
+	uint32_t i;
+	bool has_bfpt = false;
+	bool has_bait = false;
+	int ret;
+
+	ret = spi_nor_read_sfdp(0U, header, sizeof(header));
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (header[0] != SFDP_SIGNATURE) {
+		return -ENOENT;
+	}
+
+	nph = MIN(((header[1] >> 16) & 0xFFU) + 1U, SFDP_MAX_PARAM_HEADERS);
+
+	/* Later headers for the same table are newer revisions */
+	for (i = 0U; i < nph; i++) {
+		ret = spi_nor_read_sfdp(SFDP_HEADER_SIZE + (i * SFDP_PARAM_HEADER_SIZE),
+					param, sizeof(param));
+		if (ret != 0) {
+			return ret;
+		}
+
+		id = ((param[1] >> 16) & 0xFF00U) | (param[0] & 0xFFU);
+		len = param[0] >> 24;
+		ptp = param[1] & 0xFFFFFFU;
+
+		if ((id == SFDP_BFPT_ID) && (len >= SFDP_BFPT_DWORDS)) {
+			ret = spi_nor_read_sfdp(ptp, bfpt, sizeof(bfpt));
+			has_bfpt = true;
+		} else if ((id == SFDP_4BAIT_ID) && (len >= SFDP_4BAIT_DWORDS)) {
+			ret = spi_nor_read_sfdp(ptp, bait, sizeof(bait));
+			has_bait = true;
+		}
+
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	if (!has_bfpt) {
+		return -ENOENT;
+	}
+
+	spi_nor_sfdp_select_read(bfpt);
+
+	if (((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) &&
+	    ((nor_dev.flags & SPI_NOR_NO_4B_OPS) == 0U) && has_bait) {
+		spi_nor_sfdp_use_4b(bfpt, bait);
+	}
+
+	return 0;
+}
+
 static int spi_nor_erase(unsigned int offset)
 {
 	int ret;
@@ -350,79 +641,162 @@ int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
 	return 0;
 }
 
+/* Program one program_size page at offset and wait for it to complete */
+static int spi_nor_program_page(unsigned int offset, uint8_t *buf)
+{
+	int ret;
+
+	nor_dev.write_op.addr.val = offset;
+	nor_dev.write_op.data.buf = (void *)buf;
+	nor_dev.write_op.data.nbytes = nor_dev.program_size;
+
+	/* The sector read-back leaves the bank register at 0 */
+	if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
+		ret = spi_nor_write_bar(nor_dev.write_op.addr.val);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	/* Write Enable */
+	ret = spi_nor_write_en();
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = spi_mem_exec_op(&nor_dev.write_op);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Check for write in progress*/
+	return spi_nor_wait_ready();
+}
+
+/* Returns true if every byte of buf is in the erased state */
+static bool spi_nor_is_erased(const uint8_t *buf, size_t length)
+{
+	size_t i;
+
+	for (i = 0U; i < length; i++) {
+		if (buf[i] != 0xFFU) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Write length bytes at offset. Each sector touched is read back first: if the
+ * new data only clears bits, only the pages whose contents change are
+ * programmed. Otherwise the sector is erased and only the pages that are not
+ * left fully erased are programmed.
+ */
 int spi_nor_write(unsigned int offset, uintptr_t buffer, size_t length)
 {
 	int ret;
 	size_t buf_len;
 	size_t rd_len;
+	size_t i;
 	uint8_t *wr_buf = (uint8_t *)buffer;
-	uint32_t selected_sector = 0;
+	uint32_t sector_base;
+	uint32_t page;
 	unsigned int buffer_offset = 0;
+	unsigned int page_start;
+	unsigned int page_end;
+	bool need_erase;
 	uint8_t *buf = (uint8_t *) nor_dev.erase_op.data.buf;
 
 	VERBOSE("%s offset %i length %zu\n", __func__, offset, length);
 
 	while(length != 0) {
 
-		selected_sector = offset / nor_dev.erase_size;
-		
+		sector_base = (offset / nor_dev.erase_size) * nor_dev.erase_size;
+
 		/* Read sector data */
-		ret = spi_nor_read((nor_dev.erase_size * selected_sector), (uintptr_t)buf, nor_dev.erase_size, &rd_len);
-		if (rd_len != nor_dev.erase_size) {
+		ret = spi_nor_read(sector_base, (uintptr_t)buf, nor_dev.erase_size, &rd_len);
+		if ((ret != 0) || (rd_len != nor_dev.erase_size)) {
 			spi_nor_clean_bar();
 			return -1;
 		}
-		/* Erase Operation */
-		ret = spi_nor_erase(nor_dev.erase_size * selected_sector);
-		if (ret != 0) {
-			return ret;
-		}
 
 		/* Calulate length to write in a sector */
-		buffer_offset = offset - (nor_dev.erase_size * selected_sector);
+		buffer_offset = offset - sector_base;
 		buf_len = nor_dev.erase_size - buffer_offset;
 		if (length < buf_len) {
 			buf_len = length;
 		}
-		
-		/* Update Buffer */
-		memcpy(buf + buffer_offset, wr_buf, buf_len);
-		
-		nor_dev.write_op.data.buf = (void *)buf;
-		nor_dev.write_op.data.nbytes = nor_dev.program_size;
-
-		for (uint32_t i = 0; i < (nor_dev.erase_size/nor_dev.program_size); i++) {
-			
-			nor_dev.write_op.addr.val = (nor_dev.erase_size * selected_sector) + (i * nor_dev.program_size);
-			
-			/* Write Enable */
-			ret = spi_nor_write_en();
-			if (ret != 0) {
-				spi_nor_clean_bar();
-				return ret;
+
+		/* Programming can only clear bits, anything else needs an erase */
+		need_erase = false;
+		for (i = 0U; i < buf_len; i++) {
+			if ((buf[buffer_offset + i] & wr_buf[i]) != wr_buf[i]) {
+				need_erase = true;
+				break;
 			}
+		}
 
-			ret = spi_mem_exec_op(&nor_dev.write_op);
+		if (need_erase) {
+			/* Erase Operation */
+			ret = spi_nor_erase(sector_base);
+			if (ret == 0) {
+				ret = spi_nor_wait_ready();
+			}
 			if (ret != 0) {
 				spi_nor_clean_bar();
 				return ret;
 			}
+			nor_dev.erase_count++;
 
-			/* Check for write in progress*/
-			ret = spi_nor_wait_ready();
+			/* Update Buffer */
+			memcpy(buf + buffer_offset, wr_buf, buf_len);
+		} else {
+			nor_dev.erase_skipped++;
+		}
+
+		for (page = 0U; page < (nor_dev.erase_size / nor_dev.program_size); page++) {
+			page_start = page * nor_dev.program_size;
+			page_end = page_start + nor_dev.program_size;
+
+			if (need_erase) {
+				/* Pages left erased need no programming */
+				if (spi_nor_is_erased(buf + page_start, nor_dev.program_size)) {
+					nor_dev.program_skipped++;
+					continue;
+				}
+			} else {
+				/* Only program the pages the new data changes */
+				if ((page_end <= buffer_offset) || (page_start >= (buffer_offset + buf_len))) {
+					continue;
+				}
+				page_start = MAX(page_start, buffer_offset);
+				page_end = MIN(page_end, buffer_offset + (unsigned int)buf_len);
+				if (memcmp(buf + page_start, wr_buf + (page_start - buffer_offset), page_end - page_start) == 0) {
+					nor_dev.program_skipped++;
+					continue;
+				}
+				memcpy(buf + page_start, wr_buf + (page_start - buffer_offset), page_end - page_start);
+				page_start = page * nor_dev.program_size;
+			}
+
+			ret = spi_nor_program_page(sector_base + page_start, buf + page_start);
 			if (ret != 0) {
 				spi_nor_clean_bar();
 				return ret;
 			}
-			unsigned char *bufPtr = (unsigned char *)(nor_dev.write_op.data.buf) + nor_dev.program_size;
-			nor_dev.write_op.data.buf = (void *)bufPtr;
+			nor_dev.program_count++;
 		}
+
 		offset = offset + buf_len;
 		wr_buf = wr_buf + buf_len;
 		/* Update Length */
 		length = length - buf_len;
 	}
 
+	VERBOSE("%s erases %u (%u skipped), page programs %u (%u skipped)\n", __func__,
+		nor_dev.erase_count, nor_dev.erase_skipped, nor_dev.program_count, nor_dev.program_skipped);
+
 	if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
 		ret = spi_nor_clean_bar();
 		if (ret != 0) {
@@ -438,6 +812,11 @@ int spi_nor_write(unsigned int offset, uintptr_t buffer, size_t length)
 	return 0;
 }
 
+struct nor_device *spi_nor_get_device(void)
+{
+	return &nor_dev;
+}
+
 int spi_nor_init(unsigned long long *size, unsigned int *erase_size)
 {
 	int ret;
@@ -497,6 +876,12 @@ int spi_nor_init(unsigned long long *size, unsigned int *erase_size)
 		return ret;
 	}
 
+	if ((nor_dev.flags & SPI_NOR_USE_SFDP) != 0U) {
+		if (spi_nor_sfdp_setup() != 0) {
+			WARN("SPI NOR: no usable SFDP, keeping platform ops\n");
+		}
+	}
+
 	if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
 		switch (id) {
 		case SPANSION_ID:
@@ -8,6 +8,7 @@
 #include <inttypes.h>
 #include <stdint.h>
 
+#include <drivers/delay_timer.h>
 #include <drivers/spi_mem.h>
 #include <lib/utils_def.h>
 #include <libfdt.h>
@@ -174,6 +175,64 @@ int spi_mem_exec_op(const struct spi_mem_op *op)
 	return ret;
 }
 
+/*
+ * spi_mem_poll_status() - Poll a register until it reaches a given value.
+ * @op: The 1-byte register read operation.
+ * @mask: Bits of the register to check.
+ * @match: Expected value of the masked bits.
+ * @timeout_us: Polling timeout in microseconds.
+ *
+ * Uses the bus poll_status op when available, so that the bus is only
+ * claimed once. Otherwise falls back to repeated memory operations.
+ *
+ * Return: 0 in case of success, a negative error code otherwise.
+ */
+int spi_mem_poll_status(const struct spi_mem_op *op, uint8_t mask,
+			uint8_t match, unsigned int timeout_us)
+{
+	const struct spi_bus_ops *ops = spi_slave.ops;
+	uint8_t *val = op->data.buf;
+	uint64_t timeout;
+	int ret;
+
+	if ((op->data.dir != SPI_MEM_DATA_IN) || (op->data.nbytes != 1U)) {
+		return -EINVAL;
+	}
+
+	if (ops->poll_status == NULL) {
+		timeout = timeout_init_us(timeout_us);
+		do {
+			ret = spi_mem_exec_op(op);
+			if (ret != 0) {
+				return ret;
+			}
+
+			if ((*val & mask) == match) {
+				return 0;
+			}
+		} while (!timeout_elapsed(timeout));
+
+		return -ETIMEDOUT;
+	}
+
+	if (!spi_mem_supports_op(op)) {
+		WARN("Error in spi_mem_support\n");
+		return -ENOTSUP;
+	}
+
+	ret = ops->claim_bus(spi_slave.cs);
+	if (ret != 0) {
+		WARN("Error claim_bus\n");
+		return ret;
+	}
+
+	ret = ops->poll_status(op, mask, match, timeout_us);
+
+	ops->release_bus();
+
+	return ret;
+}
+
 /*
  * spi_mem_init_slave() - SPI slave device initialization.
  * @fdt: Pointer to the device tree blob.
@@ -17,6 +17,7 @@
 #define ADI_C2C_MAX_TRIM_CENTER 50
 #define ADI_C2C_MAX_AXI_WAIT 50
 #define ADI_C2C_MAX_TRAIN_WAIT 500
+#define ADI_C2C_VERIFY_MARGIN 2         /* trims either side of a stored trim checked before reusing it */
 
 #define ADI_C2C_GET_COMBINED_STAT(stats, trim)       (stats)[trim]
 #define ADI_C2C_GET_LANE_STAT(stats, trim, lane)     (0xFF & (ADI_C2C_GET_COMBINED_STAT(stats, trim) >> (8 * (lane))))
@@ -100,6 +101,15 @@ struct adi_c2cc_training_settings {
 	struct adi_c2cc_training_generator_settings generator;
 	struct adi_c2cc_training_delay_settings p2s_delay;      /* primary-to-secondary */
 	struct adi_c2cc_training_delay_settings s2p_delay;      /* secondary-to-primary */
+	uint8_t coarse_step;                                    /* trim step of the first pass, 0 for an exhaustive sweep */
+};
+
+/* Result of a training, can be stored and verified on a later boot */
+struct adi_c2cc_trim_settings {
+	uint8_t p2s_trim;
+	uint8_t s2p_trim;
+	uint8_t p2s_delays[ADI_C2C_LANE_COUNT];
+	uint8_t s2p_delays[ADI_C2C_LANE_COUNT];
 };
 
 struct adi_c2cc_calibration_settings {
@@ -112,7 +122,7 @@ struct adi_c2cc_calibration_settings {
 
 void adi_c2cc_init(uintptr_t pri_base, uintptr_t sec_base, c2c_mode_t mode);
 bool adi_c2cc_enable(void);
-bool adi_c2cc_enable_high_speed(struct adi_c2cc_training_settings *params);
+bool adi_c2cc_enable_high_speed(struct adi_c2cc_training_settings *params, const struct adi_c2cc_trim_settings *known, struct adi_c2cc_trim_settings *result);
 bool adi_c2cc_enable_hw_bg_cal(struct adi_c2cc_calibration_settings *params, struct adi_c2cc_training_generator_settings *prbs_params);
 
 /* used by BL31 */
@@ -125,6 +135,8 @@ bool adi_c2cc_enable_error_handling(c2c_err_handler_t *pri_params, c2c_err_handl
 /* used by adrv906x_cli.c */
 bool adi_c2cc_setup_train(struct adi_c2cc_training_settings *params);
 bool adi_c2cc_run_train(uint32_t *p2s_stats, uint32_t *s2p_stats, uint8_t *p2s_delays, uint8_t *s2p_delays);
+bool adi_c2cc_run_train_coarse(uint32_t *p2s_stats, uint32_t *s2p_stats, uint8_t *p2s_delays, uint8_t *s2p_delays, unsigned int step);
+bool adi_c2cc_verify_training(const struct adi_c2cc_trim_settings *trims, unsigned int margin);
 bool adi_c2cc_analyze_train_data(uint32_t *p2s_stats, uint32_t *s2p_stats, size_t min_size, size_t max_spread, size_t max_center, uint8_t *p2s_trim_delays, uint8_t *s2p_trim_delays, uint8_t *p2s_trim, uint8_t *s2p_trim);
 bool adi_c2cc_apply_training(uint8_t p2s_trim, uint8_t s2p_trim, struct adi_c2cc_training_clock_settings *tx_clk);
 bool adi_c2cc_run_loopback_test();
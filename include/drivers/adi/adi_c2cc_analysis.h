@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ADI_C2CC_ANALYSIS_H
+#define ADI_C2CC_ANALYSIS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+uint8_t adi_c2cc_find_optimal_trim(uint32_t *stats, size_t min_size, size_t max_spread, size_t max_center, uint8_t *trim_delays, size_t *eye_width);
+
+/* Gathers the statistics of one trim value in both directions */
+typedef bool (*adi_c2cc_measure_fn_t)(uint8_t trim, uint32_t *p2s_stat, uint32_t *s2p_stat);
+
+bool adi_c2cc_coarse_sweep(uint32_t *p2s_stats, uint32_t *s2p_stats, unsigned int step, bool p2s_only, adi_c2cc_measure_fn_t measure, unsigned int *measured);
+
+#endif /* ADI_C2CC_ANALYSIS_H */
@@ -38,4 +38,13 @@ int otp_read_burst(const uintptr_t mem_ctrl_base, const uintptr_t addr, uint32_t
 int otp_write(const uintptr_t mem_ctrl_base, const uintptr_t addr, uint32_t data, uint8_t ecc_state);
 int otp_write_burst(const uintptr_t mem_ctrl_base, const uintptr_t addr, const uint32_t *buffer, size_t len, uint8_t ecc_state);
 
+/*
+ * Read len words starting at addr into buffer and keep it as a shadow copy:
+ * later otp_read()/otp_read_burst() calls with the same base and ecc_state that
+ * fall inside the range are served from buffer. Any otp write drops the copy.
+ * otp_shadow_get_hits() returns the number of words served from the copy.
+ */
+int otp_shadow_init(const uintptr_t mem_ctrl_base, const uintptr_t addr, uint32_t *buffer, size_t len, uint8_t ecc_state);
+uint32_t otp_shadow_get_hits(void);
+
 #endif /* ADI_OTP_H */
@@ -24,4 +24,7 @@ struct adi_qspi_ctrl {
 int adi_qspi_init(struct adi_qspi_ctrl *params);
 void adi_qspi_deinit(uintptr_t qspi_base, uintptr_t tx_dde_base, uintptr_t rx_dde_base);
 
+/* Total bytes read in data phases and the system counter ticks spent on them */
+void adi_qspi_get_rx_stats(uint64_t *bytes, uint64_t *ticks);
+
 #endif /* ADI_QSPI_H */
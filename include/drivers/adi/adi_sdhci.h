@@ -15,16 +15,22 @@ struct adi_mmc_params {
 	uintptr_t reg_base;
 	uintptr_t phy_reg_base;
 	unsigned int clk_rate;
+	unsigned int hs_clk_rate;               /* Card clock in HS200/HS400, 0 if not supported */
 	unsigned int bus_width;
 	unsigned int flags;
 	unsigned int src_clk_hz;
 	struct mmc_device_info *device_info;
 	bool use_dma;
 	bool phy_config_needed;
+	uint32_t tuning_cache;                  /* Result of a previous tuning, 0 if none */
+	void (*save_tuning_cache)(uint32_t cache); /* Optional, called when the tuning result changes */
 };
 
 int adi_mmc_init(struct adi_mmc_params *params);
 
 int adi_mmc_deinit(uintptr_t reg_base);
 
+/* Total bytes read in data transfers and the system counter ticks spent on them */
+void adi_mmc_get_read_stats(uint64_t *bytes, uint64_t *ticks);
+
 #endif /* ADI_SDHCI_H */
@@ -24,6 +24,13 @@
 #define DDR_SIZE_3GB   0xC0000000
 #define DDR_HDTCTRL_MAX_VERBOSITY 0x04
 
+/* Patterns for ddr_simd_mem_test(), may be combined */
+#define DDR_MEM_TEST_MATS_PLUS     (1U << 0)    /* MATS+ march: up(r0,w1), down(r1,w0) */
+#define DDR_MEM_TEST_CHECKERBOARD  (1U << 1)    /* Alternating 0x55/0xAA words and inverse */
+#define DDR_MEM_TEST_ADDRESS       (1U << 2)    /* Address-in-address and its complement */
+#define DDR_MEM_TEST_ALL           (DDR_MEM_TEST_MATS_PLUS | DDR_MEM_TEST_CHECKERBOARD | DDR_MEM_TEST_ADDRESS)
+#define DDR_MEM_TEST_ALIGN         (64)         /* Test granularity, base and size alignment */
+
 typedef enum {
 	DDR_INIT_FULL,
 	DDR_PRE_RESET_INIT,
@@ -46,7 +53,8 @@ typedef enum {
 	ERROR_DDR_PHY_FW_FAILED,
 	ERROR_DDR_BASIC_MEM_TEST_FAILED,
 	ERROR_DDR_EXTENSIVE_MEM_TEST_FAILED,
-	ERROR_DDR_ECC_SCRUB_FAILED
+	ERROR_DDR_ECC_SCRUB_FAILED,
+	ERROR_DDR_BIST_FAILED
 } ddr_error_t;
 
 typedef struct {
@@ -59,6 +67,15 @@ typedef struct {
 	uint16_t error_count;
 } ddr_ecc_error_data_t;
 
+/* Accumulated by ddr_bist_mem_test(), zero it before the first call */
+typedef struct {
+	uint32_t corrected;                     /* Correctable ECC errors seen by the read passes */
+	uint32_t uncorrected;                   /* Uncorrectable ECC errors seen by the read passes */
+	bool failed;
+	uint32_t first_fail_pattern;            /* Pattern of the first failing pass */
+	ddr_ecc_error_data_t first_error;       /* Location of the first error of that pass */
+} ddr_bist_result_t;
+
 typedef enum {
 	DDR_MASTER0,
 	DDR_ANIB,
@@ -81,8 +98,16 @@ typedef struct {
 	uint32_t master_cal_rate;               /* Impedance Calibration Rate Control */
 } ddr_custom_values_t;
 
+typedef struct {
+	uint64_t errors;                        /* Number of failing 64 byte blocks */
+	uintptr_t first_fail;                   /* Address of the first failing block */
+	uint32_t first_fail_pattern;            /* DDR_MEM_TEST_* pattern that found it */
+} ddr_mem_test_result_t;
+
 ddr_error_t ddr_basic_mem_test(uintptr_t base_addr_ddr, uint32_t size, bool restore);
 ddr_error_t ddr_extensive_mem_test(uintptr_t base_addr_ddr, uint32_t size);
+ddr_error_t ddr_bist_mem_test(uintptr_t base_addr_ctrl, uint32_t ddr_size, ddr_config_t configuration, const uint32_t *patterns, unsigned int num_patterns, ddr_bist_result_t *result);
+void ddr_simd_mem_test(uintptr_t base_addr_ddr, uint64_t size, uint32_t patterns, ddr_mem_test_result_t *result);
 ddr_error_t ddr_init(uintptr_t base_addr_ctrl, uintptr_t base_addr_phy, uintptr_t base_addr_adi_interface, uintptr_t base_addr_clk, uintptr_t base_addr_ddr, uint32_t ddr_size, uint32_t ddr_remap_size, uint8_t ddr_dfi_pad_sequence[], uint8_t ddr_phy_pad_sequence[], ddr_init_stages_t stage, ddr_config_t configuration, bool ecc);
 ddr_error_t ddr_pre_reset_init(uintptr_t base_addr_ctrl, bool ecc);
 ddr_error_t ddr_post_reset_init(uintptr_t base_addr_ctrl, uintptr_t base_addr_phy, uintptr_t base_addr_adi_interface, uintptr_t base_addr_clk, ddr_init_stages_t stage, ddr_config_t configuration);
@@ -92,6 +117,8 @@ ddr_error_t ddr_custom_training_test(uintptr_t base_addr_phy, uint8_t hdt_ctrl,
 /* DDR ECC reporting functions */
 bool ddr_get_ecc_error_info(uintptr_t base_addr_ctrl, bool correctable, ddr_ecc_error_data_t *data);
 void ddr_clear_ap_error(uintptr_t base_addr_ctrl);
+void ddr_get_ecc_error_counts(uintptr_t base_addr_ctrl, uint16_t *corrected, uint16_t *uncorrected);
+void ddr_clear_ecc_error_counts(uintptr_t base_addr_ctrl);
 
 /* Debug-only functions */
 void ddr_mux_set_output(uintptr_t base_addr_phy, uintptr_t base_addr_adi_interface, uintptr_t base_addr_clk, uint8_t group, uint8_t instance, uint8_t source);
@@ -51,6 +51,7 @@ static inline void auth_mod_init(void)
 }
 #endif /* TRUSTED_BOARD_BOOT */
 int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id);
+unsigned int auth_mod_get_parent_cache_hits(void);
 int auth_mod_verify_img(unsigned int img_id,
 			void *img_ptr,
 			unsigned int img_len);
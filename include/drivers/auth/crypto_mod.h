@@ -79,6 +79,16 @@ typedef struct crypto_lib_desc_s {
 			    unsigned int key_flags, const void *iv,
 			    unsigned int iv_len, const void *tag,
 			    unsigned int tag_len);
+
+	/*
+	 * Hash a buffer while it is being filled (optional). The digest is
+	 * kept by the library and used by verify_hash()/calc_hash() when they
+	 * are later called on the same buffer with the same algorithm.
+	 */
+	int (*hash_stream_start)(void *data_ptr, unsigned int data_len);
+	int (*hash_stream_update)(void *data_ptr, unsigned int data_len);
+	int (*hash_stream_finish)(void);
+	int (*hash_stream_discard)(void);
 } crypto_lib_desc_t;
 
 /* Public functions */
@@ -118,6 +128,13 @@ int crypto_mod_calc_hash(enum crypto_md_algo alg, void *data_ptr,
 int crypto_mod_convert_pk(void *full_pk_ptr, unsigned int full_pk_len,
 			  void **hashed_pk_ptr, unsigned int *hashed_pk_len);
 
+#if CRYPTO_SUPPORT
+int crypto_mod_hash_stream_start(void *data_ptr, unsigned int data_len);
+int crypto_mod_hash_stream_update(void *data_ptr, unsigned int data_len);
+int crypto_mod_hash_stream_finish(void);
+void crypto_mod_hash_stream_discard(void);
+#endif /* CRYPTO_SUPPORT */
+
 /* Macro to register a cryptographic library */
 #define REGISTER_CRYPTO_LIB(_name, _init, _verify_signature, _verify_hash, \
 			    _calc_hash, _auth_decrypt, _convert_pk) \
@@ -131,6 +148,26 @@ int crypto_mod_convert_pk(void *full_pk_ptr, unsigned int full_pk_len,
 		.convert_pk = _convert_pk \
 	}
 
+/* Same as REGISTER_CRYPTO_LIB(), for libraries that can hash while loading */
+#define REGISTER_CRYPTO_LIB_HASH_STREAM(_name, _init, _verify_signature,   \
+			    _verify_hash, _calc_hash, _auth_decrypt,	   \
+			    _convert_pk, _hash_stream_start,		   \
+			    _hash_stream_update, _hash_stream_finish,	   \
+			    _hash_stream_discard)			   \
+	const crypto_lib_desc_t crypto_lib_desc = { \
+		.name = _name, \
+		.init = _init, \
+		.verify_signature = _verify_signature, \
+		.verify_hash = _verify_hash, \
+		.calc_hash = _calc_hash, \
+		.auth_decrypt = _auth_decrypt, \
+		.convert_pk = _convert_pk, \
+		.hash_stream_start = _hash_stream_start, \
+		.hash_stream_update = _hash_stream_update, \
+		.hash_stream_finish = _hash_stream_finish, \
+		.hash_stream_discard = _hash_stream_discard \
+	}
+
 extern const crypto_lib_desc_t crypto_lib_desc;
 
 #endif /* CRYPTO_MOD_H */
@@ -60,6 +60,7 @@
 #define CMD_EXTCSD_PARTITION_CONFIG	179
 #define CMD_EXTCSD_BUS_WIDTH		183
 #define CMD_EXTCSD_HS_TIMING		185
+#define CMD_EXTCSD_DEVICE_TYPE		196
 #define CMD_EXTCSD_PART_SWITCH_TIME	199
 #define CMD_EXTCSD_SEC_CNT		212
 #define CMD_EXTCSD_BOOT_SIZE_MULT	226
@@ -82,6 +83,16 @@
 #define MMC_BOOT_MODE_BACKWARD		(U(0) << 3)
 #define MMC_BOOT_MODE_HS_TIMING		(U(1) << 3)
 #define MMC_BOOT_MODE_DDR		(U(2) << 3)
+#define EXT_CSD_DEVICE_TYPE_HS200_1_8V	BIT(4)
+#define EXT_CSD_DEVICE_TYPE_HS400_1_8V	BIT(6)
+
+/* Bus timings, values match the EXT CSD HS_TIMING field */
+#define MMC_TIMING_LEGACY		U(0)
+#define MMC_TIMING_HS			U(1)
+#define MMC_TIMING_HS200		U(2)
+#define MMC_TIMING_HS400		U(3)
+#define MMC_HS_MAX_BUS_FREQ		U(52000000)
+#define MMC_HS200_MAX_BUS_FREQ		U(200000000)
 
 #define EXTCSD_SET_CMD			(U(0) << 24)
 #define EXTCSD_SET_BITS			(U(1) << 24)
@@ -113,6 +124,11 @@
 
 #define MMC_FLAG_CMD23			(U(1) << 0)
 #define MMC_FLAG_SD_CMD6		(U(1) << 1)
+/* Host controller issues CMD23 itself (Auto CMD23), implies MMC_FLAG_CMD23 */
+#define MMC_FLAG_AUTO_CMD23		(U(1) << 2)
+/* Select HS200 (and HS400 from it) on eMMC, needs set_timing and execute_tuning ops */
+#define MMC_FLAG_HS200			(U(1) << 3)
+#define MMC_FLAG_HS400			(U(1) << 4)
 
 #define CMD8_CHECK_PATTERN		U(0xAA)
 #define VHS_2_7_3_6_V			BIT(8)
@@ -138,6 +154,9 @@ struct mmc_ops {
 	int (*prepare)(int lba, uintptr_t buf, size_t size);
 	int (*read)(int lba, uintptr_t buf, size_t size);
 	int (*write)(int lba, const uintptr_t buf, size_t size);
+	/* Optional, needed for HS200/HS400 */
+	int (*set_timing)(unsigned int timing);
+	int (*execute_tuning)(void);
 };
 
 struct mmc_csd_emmc {
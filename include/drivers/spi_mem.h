@@ -121,9 +121,25 @@ struct spi_bus_ops {
 	 * Returns: 0 on success, a negative error code otherwise.
 	 */
 	int (*exec_op)(const struct spi_mem_op *op);
+
+	/*
+	 * Poll a 1-byte register read until (value & mask) == match, without
+	 * releasing the bus between reads. Optional.
+	 *
+	 * @op:	The register read operation.
+	 * @mask: Bits of the register to check.
+	 * @match: Expected value of the masked bits.
+	 * @timeout_us: Polling timeout in microseconds.
+	 * Returns: 0 on match, -ETIMEDOUT or another negative error code
+	 * otherwise.
+	 */
+	int (*poll_status)(const struct spi_mem_op *op, uint8_t mask,
+			   uint8_t match, unsigned int timeout_us);
 };
 
 int spi_mem_exec_op(const struct spi_mem_op *op);
+int spi_mem_poll_status(const struct spi_mem_op *op, uint8_t mask,
+			uint8_t match, unsigned int timeout_us);
 int spi_mem_init_slave(void *fdt, int bus_node,
 		       const struct spi_bus_ops *ops);
 int spi_mem_init_slave_nofdt(int mode, unsigned int cs, unsigned int max_hz, const struct spi_bus_ops *ops);
@@ -31,6 +31,18 @@
 #define SPI_NOR_OP_READ_1_2_2	0xBBU	/* Read data bytes (Dual I/O SPI) */
 #define SPI_NOR_OP_READ_1_1_4	0x6BU	/* Read data bytes (Quad Output SPI) */
 #define SPI_NOR_OP_READ_1_4_4	0xEBU	/* Read data bytes (Quad I/O SPI) */
+#define SPI_NOR_OP_READ_SFDP	0x5AU	/* Read SFDP parameters */
+
+/* 4-byte address opcodes */
+#define SPI_NOR_OP_READ_4B		0x13U
+#define SPI_NOR_OP_READ_FAST_4B		0x0CU
+#define SPI_NOR_OP_READ_1_1_2_4B	0x3CU
+#define SPI_NOR_OP_READ_1_2_2_4B	0xBCU
+#define SPI_NOR_OP_READ_1_1_4_4B	0x6CU
+#define SPI_NOR_OP_READ_1_4_4_4B	0xECU
+#define SPI_NOR_OP_PAGE_PROGRAM_4B	0x12U
+#define SPI_NOR_OP_WRITE_1_1_4_4B	0x34U
+#define SPI_NOR_OP_WRITE_1_4_4_4B	0x3EU
 
 #define SPI_NOR_OP_PAGE_PROGRAM	0x02U	/* Write data bytes (low frequency) */
 #define SPI_NOR_OP_WRITE_1_1_2	0xA2U	/* Write data bytes (Dual Output SPI) */
@@ -41,6 +53,8 @@
 /* Flags for NOR specific configuration */
 #define SPI_NOR_USE_FSR		BIT(0)
 #define SPI_NOR_USE_BANK	BIT(1)
+#define SPI_NOR_USE_SFDP	BIT(2)	/* Pick read mode and 4-byte opcodes from SFDP */
+#define SPI_NOR_NO_4B_OPS	BIT(3)	/* Keep bank switching over SFDP 4-byte opcodes */
 
 struct nor_device {
 	struct spi_mem_op erase_op;
@@ -53,6 +67,11 @@ struct nor_device {
 	uint8_t bank_read_cmd;
 	uint32_t erase_size;
 	uint32_t program_size;
+	/* Write statistics, erases and page programs done and avoided */
+	uint32_t erase_count;
+	uint32_t erase_skipped;
+	uint32_t program_count;
+	uint32_t program_skipped;
 };
 
 int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
@@ -60,6 +79,12 @@ int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
 int spi_nor_write(unsigned int offset, uintptr_t buffer, size_t length);
 int spi_nor_init(unsigned long long *device_size, unsigned int *erase_size);
 
+/*
+ * NOR instance in use, for tests and diagnostics. Flags set here are kept by
+ * the next spi_nor_init().
+ */
+struct nor_device *spi_nor_get_device(void);
+
 /*
  * Platform can implement this to override default NOR instance configuration.
  *
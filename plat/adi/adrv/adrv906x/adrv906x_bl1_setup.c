@@ -102,6 +102,7 @@ void plat_bl1_setup(void)
 
 	/* Init OTP driver */
 	adrv906x_otp_init_driver();
+	adrv906x_otp_init_shadow(OTP_BASE);
 
 	/* Initialize GPIO framework */
 	adrv906x_gpio_init(GPIO_MODE_SECURE_BASE, SEC_GPIO_MODE_SECURE_BASE);
@@ -28,6 +28,7 @@
 #include <adrv906x_mmap.h>
 #include <adrv906x_otp.h>
 #include <adrv906x_peripheral_clk_rst.h>
+#include <adrv906x_status_reg.h>
 #include <adrv906x_tsgen.h>
 #include <platform_def.h>
 #include <plat_boot.h>
@@ -329,6 +330,12 @@ static void init(void)
 		plat_error_handler(-EDINIT);
 	}
 
+#ifdef DDR_BIST_AT_BOOT
+	adrv906x_ddr_boot_bist();
+#else
+	adrv906x_wr_priv_status_reg(DDR_BIST, 0);
+#endif
+
 	/* Skip printing clock info on Protium and Palladium since it is time consuming */
 	if (!plat_is_protium() && !plat_is_palladium()) {
 		clk_print_info(CLK_CTL);
@@ -376,6 +383,7 @@ void plat_bl2_setup(void)
 {
 	/* Init OTP driver */
 	adrv906x_otp_init_driver();
+	adrv906x_otp_init_shadow(OTP_BASE);
 
 	/* Setup the device profile */
 	plat_dprof_init();
@@ -23,6 +23,7 @@
 #include <adrv906x_spu_def.h>
 #include <adrv906x_device_profile.h>
 #include <adrv906x_pinmux_source_def.h>
+#include <adrv906x_status_reg.h>
 #include <platform_def.h>
 #include <plat_boot.h>
 #include <plat_pinctrl.h>
@@ -36,6 +37,12 @@
 
 static bool is_boot_dev_init = false;
 
+/* Keep the eMMC tuning result across warm resets */
+static void save_emmc_tuning(uint32_t cache)
+{
+	adrv906x_wr_priv_status_reg(EMMC_TUNING, cache);
+}
+
 static void init_sysc_mmc(uintptr_t base)
 {
 	struct mmc_device_info mmc_info;
@@ -73,6 +80,9 @@ static void init_mmc(enum mmc_device_type device)
 		/* eMMC interface of dwc_mshc includes a PHY solution */
 		mmc_params.phy_config_needed = true;
 		mmc_params.phy_reg_base = EMMC_0_PHY_BASE;
+		mmc_params.hs_clk_rate = EMMC_0_HS_CLK_RATE_HZ;
+		mmc_params.tuning_cache = adrv906x_rd_priv_status_reg(EMMC_TUNING);
+		mmc_params.save_tuning_cache = save_emmc_tuning;
 	} else { /* MMC_IS_SD */
 		mmc_params.reg_base = SD_0_BASE;
 		mmc_params.clk_rate = SD_0_CLK_RATE_HZ;
@@ -88,7 +98,7 @@ static void init_mmc(enum mmc_device_type device)
 	mmc_params.src_clk_hz = clk_get_freq(CLK_CTL, CLK_ID_EMMC);
 	mmc_params.device_info = &mmc_info;
 	mmc_params.use_dma = true;
-	mmc_params.flags = MMC_FLAG_CMD23;
+	mmc_params.flags = MMC_FLAG_CMD23 | MMC_FLAG_AUTO_CMD23 | MMC_FLAG_HS200;
 
 	/* If the interface is SD, configure the pinmux to enable these pins*/
 	if (device != MMC_IS_EMMC)
@@ -394,6 +394,122 @@ static int ddr_extensive_mem_test_command_function(uint8_t *command_buffer, bool
 	return result;
 }
 
+/* This command performs the multi-core SIMD mem test for the DDR */
+static int ddr_parallel_mem_test_command_function(uint8_t *command_buffer, bool help)
+{
+	uint64_t base_addr_ddr;
+	uint64_t size;
+	uint64_t cores;
+	uint64_t patterns;
+	int result = 0;
+	bool ret = true;
+
+	if (help) {
+		printf("ddrparmemtest <addr> <size> <cores> <patterns> ");
+		printf("Performs a memory test of (hex)<size>, starting from (hex)<addr>, split across <cores> cores.\n");
+		printf("                                               ");
+		printf("<patterns> bitmask: 1=MATS+, 2=checkerboard, 4=address-in-address. <addr> and <size> must be 64 byte aligned.\n");
+	} else {
+		command_buffer = parse_next_param(16, command_buffer, &base_addr_ddr);
+		if (command_buffer == NULL)
+			return -1;
+
+		command_buffer = parse_next_param(16, command_buffer, &size);
+		if (command_buffer == NULL)
+			return -1;
+
+		command_buffer = parse_next_param(10, command_buffer, &cores);
+		if (command_buffer == NULL)
+			return -1;
+
+		command_buffer = parse_next_param(16, command_buffer, &patterns);
+		if (command_buffer == NULL)
+			return -1;
+
+		/* Initialize the DDR before attempting a memory test*/
+		clk_set_src(CLK_CTL, CLK_SRC_DEVCLK);
+		if (plat_get_dual_tile_enabled())
+			clk_set_src(SEC_CLK_CTL, CLK_SRC_DEVCLK);
+		ret = clk_do_mcs(plat_get_dual_tile_enabled(), plat_get_clkpll_freq_setting(), plat_get_orx_adc_freq_setting(), true);
+		if (ret == false)
+			return -1;
+
+		plat_secure_wdt_stop();
+
+		/* Configure TZC */
+		plat_security_setup();
+
+		result = adrv906x_ddr_init();
+		if (result) {
+			printf("Error initializing the DDR: %d\n", result);
+			return result;
+		}
+
+		printf("Parallel memory test invalidates the cache and leaves the secondary cores parked in BL2, reset is recommended after running.\n");
+		printf("Running the DDR parallel mem test...\n");
+		result = adrv906x_ddr_parallel_mem_test(base_addr_ddr, size, (unsigned int)cores, (uint32_t)patterns);
+		if (result)
+			printf("Error occurred during DDR parallel mem test:%d\n", result);
+		else
+			printf("Parallel memory test passed.\n");
+	}
+	return result;
+}
+
+/* This command runs the DDR controller scrubber BIST */
+static int ddr_bist_command_function(uint8_t *command_buffer, bool help)
+{
+	uint64_t pattern;
+	uint32_t patterns[2];
+	ddr_bist_result_t bist_result;
+	int result = 0;
+	bool ret = true;
+
+	if (help) {
+		printf("ddrbist <pattern>                  ");
+		printf("Performs a scrubber write/read-verify test of all DDR with (hex)<pattern> and its complement, reporting ECC errors.\n");
+	} else {
+		command_buffer = parse_next_param(16, command_buffer, &pattern);
+		if (command_buffer == NULL)
+			return -1;
+
+		patterns[0] = (uint32_t)pattern;
+		patterns[1] = ~(uint32_t)pattern;
+
+		/* Initialize the DDR before attempting a memory test*/
+		clk_set_src(CLK_CTL, CLK_SRC_DEVCLK);
+		if (plat_get_dual_tile_enabled())
+			clk_set_src(SEC_CLK_CTL, CLK_SRC_DEVCLK);
+		ret = clk_do_mcs(plat_get_dual_tile_enabled(), plat_get_clkpll_freq_setting(), plat_get_orx_adc_freq_setting(), true);
+		if (ret == false)
+			return -1;
+
+		plat_secure_wdt_stop();
+
+		/* Configure TZC */
+		plat_security_setup();
+
+		result = adrv906x_ddr_init();
+		if (result) {
+			printf("Error initializing the DDR: %d\n", result);
+			return result;
+		}
+
+		printf("Running the DDR BIST...\n");
+		result = adrv906x_ddr_bist(patterns, 2, &bist_result);
+		printf("Correctable ECC errors: %u, uncorrectable ECC errors: %u\n", bist_result.corrected, bist_result.uncorrected);
+		if (bist_result.failed)
+			printf("First failing pattern 0x%x: Rank: %d, Row: %d, Bank Group: %d, Bank: %d, Block: %d\n", bist_result.first_fail_pattern,
+			       bist_result.first_error.rank, bist_result.first_error.row, bist_result.first_error.bank_group,
+			       bist_result.first_error.bank, bist_result.first_error.block);
+		if (result)
+			printf("Error occurred during DDR BIST:%d\n", result);
+		else
+			printf("DDR BIST passed.\n");
+	}
+	return result;
+}
+
 /* Function to select which DDR signal to send to its observation pin*/
 static int  ddr_debug_mux_output_command_function(uint8_t *command_buffer, bool help)
 {
@@ -747,6 +863,7 @@ static int otp_dump_command_function(uint8_t *command_buffer, bool help)
 
 		if ((result = adrv906x_dump_otp_memory(start_addr, size)) != 0)
 			printf("Failed to dump memory from OTP.\n");
+		printf("%u OTP word reads served from the shadow copy so far.\n", otp_shadow_get_hits());
 	}
 	return result;
 }
@@ -1423,9 +1540,11 @@ cli_command_t plat_command_list[] = {
 	{ "c2ctest",	   c2c_test_command_function			  },
 	{ "c2ctrain",	   c2c_train_command_function			  },
 	{ "ddrinit",	   ddr_init_command_function			  },
+	{ "ddrbist",	   ddr_bist_command_function			  },
 	{ "ddrextmemtest", ddr_extensive_mem_test_command_function	  },
 	{ "ddrmemtest",	   ddr_mem_test_command_function		  },
 	{ "ddrmux",	   ddr_debug_mux_output_command_function	  },
+	{ "ddrparmemtest", ddr_parallel_mem_test_command_function	  },
 	{ "ddrpreinit",	   ddr_iterative_init_pre_reset_command_function  },
 	{ "ddrpostinit",   ddr_iterative_init_post_reset_command_function },
 	{ "ddrremapinit",  ddr_iterative_init_remapping_command_function  },
@@ -4,13 +4,16 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <errno.h>
+#include <string.h>
 #include <common/debug.h>
 #include <plat/common/platform.h>
 #include <lib/mmio.h>
+#include <lib/utils_def.h>
 
 #include <adrv906x_ddr.h>
 #include <adrv906x_device_profile.h>
 #include <adrv906x_nic_def.h>
+#include <adrv906x_status_reg.h>
 #include <plat_err.h>
 
 #define ATE_FW_ADDR 0x00100000
@@ -18,6 +21,9 @@
 #define ATE_MSG_BLOCK_ADDR 0x0010D000
 #define ATE_MSG_BLOCK_SIZE 0x3FFF
 
+/* Scrubber BIST patterns: all zeros, all ones and both checkerboards */
+static const uint32_t ddr_bist_default_patterns[] = { 0x00000000, 0xFFFFFFFF, 0x55555555, 0xAAAAAAAA };
+
 /* Sequence for programming the DDR pad pillar remapping registers in the ddr_adi_interface module, referred to in Yoda as the ddr_cmd_addr_remap, starting with ADDRESS0-16, then CASN, RASN, and WEN. */
 static uint8_t ddr_dfi_pad_sequence[DDR_DFI_PAD_SEQUENCE_SIZE] = { 0xC, 0x3, 0x1, 0x8, 0x2, 0xA, 0xE, 0x4, 0xD, 0x19, 0x7, 0x1A, 0x6, 0x9, 0x1E, 0x1E, 0x1E, 0x0, 0x1B, 0x5, 0xB, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 };
 static uint8_t ddr_phy_pad_sequence[DDR_PHY_PAD_SEQUENCE_SIZE] = { \
@@ -186,6 +192,64 @@ int adrv906x_ddr_extensive_mem_test(uintptr_t base_addr_ddr, uint32_t size)
 	return err;
 }
 
+/* Runs the scrubber BIST over every initialized DDR, using the default patterns if patterns is NULL.
+ * Overwrites the whole DDR. */
+int adrv906x_ddr_bist(const uint32_t *patterns, unsigned int num_patterns, ddr_bist_result_t *result)
+{
+	int err = 0;
+
+	if (patterns == NULL) {
+		patterns = ddr_bist_default_patterns;
+		num_patterns = ARRAY_SIZE(ddr_bist_default_patterns);
+	}
+	memset(result, 0, sizeof(*result));
+
+	/* The scrubber only reports ECC errors, it cannot compare data */
+	if (!plat_is_primary_ecc_enabled())
+		return -ENOTSUP;
+
+	err = ddr_bist_mem_test(DDR_CTL_BASE, plat_get_dram_physical_size(), DDR_PRIMARY_CONFIGURATION, patterns, num_patterns, result);
+	if ((err != ERROR_DDR_NO_ERROR) && (err != ERROR_DDR_BIST_FAILED))
+		return err;
+
+	if (plat_get_dual_tile_enabled() && plat_is_secondary_phys_dram_present() && plat_is_secondary_ecc_enabled())
+		err = ddr_bist_mem_test(SEC_DDR_CTL_BASE, plat_get_secondary_dram_physical_size(), DDR_SECONDARY_CONFIGURATION, patterns, num_patterns, result);
+
+	if ((err == ERROR_DDR_NO_ERROR) && result->failed)
+		err = ERROR_DDR_BIST_FAILED;
+
+	return err;
+}
+
+/* Runs the scrubber BIST at boot, right after DDR init and before anything is loaded to DDR,
+ * and records the result in the DDR_BIST private status register for the SiP service */
+void adrv906x_ddr_boot_bist(void)
+{
+	ddr_bist_result_t result;
+	uint32_t status;
+	int err;
+
+	NOTICE("Running DDR BIST.\n");
+	err = adrv906x_ddr_bist(NULL, 0, &result);
+	if ((err != ERROR_DDR_NO_ERROR) && (err != ERROR_DDR_BIST_FAILED)) {
+		plat_error_message("DDR BIST did not run %d", err);
+		adrv906x_wr_priv_status_reg(DDR_BIST, 0);
+		return;
+	}
+
+	if (result.failed)
+		plat_error_message("DDR BIST failed: %u correctable, %u uncorrectable ECC errors, first with pattern 0x%x at Rank: %d, Row: %d, Bank Group: %d, Bank: %d",
+				   result.corrected, result.uncorrected, result.first_fail_pattern,
+				   result.first_error.rank, result.first_error.row, result.first_error.bank_group, result.first_error.bank);
+	else
+		NOTICE("DDR BIST passed.\n");
+
+	status = DDR_BIST_STATUS_DONE;
+	status |= (MIN(result.uncorrected, DDR_BIST_STATUS_UNCORR_MASK >> DDR_BIST_STATUS_UNCORR_SHIFT) << DDR_BIST_STATUS_UNCORR_SHIFT);
+	status |= (MIN(result.corrected, DDR_BIST_STATUS_CORR_MASK >> DDR_BIST_STATUS_CORR_SHIFT) << DDR_BIST_STATUS_CORR_SHIFT);
+	adrv906x_wr_priv_status_reg(DDR_BIST, status);
+}
+
 /* Runs a subset of the DDR training tests */
 int adrv906x_ddr_custom_training_test(uintptr_t base_addr_phy, uint16_t sequence_ctrl, int train_2d)
 {
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/delay_timer.h>
+#include <lib/mmio.h>
+#include <lib/xlat_tables/xlat_mmu_helpers.h>
+#include <plat/common/platform.h>
+
+#include <adrv906x_ddr.h>
+#include <plat_mailbox.h>
+#include <platform_def.h>
+
+/*
+ * Parallel DDR memory test. The range is split into one slice per core and the
+ * secondary cores, still parked in the BL1 holding pen, are released through the
+ * trusted mailbox to test their slice while the primary tests its own. All cores
+ * run with the MMU off, so the job table below is shared without cache maintenance.
+ */
+#define JOB_IDLE                0U
+#define JOB_PENDING             1U      /* Released, core not yet running */
+#define JOB_RUNNING             2U
+#define JOB_DONE                3U
+#define JOB_DECLINED            4U      /* Withdrawn by the primary after the core claimed it */
+
+/* Time a released core has to pick up its job before the primary takes the slice over */
+#define JOB_START_TIMEOUT_US    10000U
+
+typedef struct {
+	uintptr_t base;
+	uint64_t size;
+	uint32_t patterns;
+	uint32_t state;
+	uint32_t cancel;        /* Written by the primary only */
+	ddr_mem_test_result_t result;
+} __aligned(CACHE_WRITEBACK_GRANULE) mem_test_job_t;
+
+static mem_test_job_t jobs[PLATFORM_CORE_COUNT];
+
+void adrv906x_ddr_mem_test_entry(void);
+void adrv906x_ddr_mem_test_worker(unsigned int core);
+
+/* Called on each released secondary core by adrv906x_ddr_mem_test_entry */
+void adrv906x_ddr_mem_test_worker(unsigned int core)
+{
+	mem_test_job_t *job = &jobs[core];
+
+	if (__atomic_load_n(&job->state, __ATOMIC_ACQUIRE) != JOB_PENDING)
+		return;
+
+	/*
+	 * Claim the job, then check the primary has not withdrawn it. With the
+	 * MMU off there are no exclusives, so each side publishes its own flag
+	 * and reads the other's after a DSB: at least one sees the other.
+	 */
+	__atomic_store_n(&job->state, JOB_RUNNING, __ATOMIC_RELEASE);
+	dsb();
+	if (__atomic_load_n(&job->cancel, __ATOMIC_ACQUIRE) != 0U) {
+		__atomic_store_n(&job->state, JOB_DECLINED, __ATOMIC_RELEASE);
+		dsb();
+		sev();
+		return;
+	}
+
+	ddr_simd_mem_test(job->base, job->size, job->patterns, &job->result);
+	__atomic_store_n(&job->state, JOB_DONE, __ATOMIC_RELEASE);
+
+	dsb();
+	sev();
+}
+
+static void release_core(unsigned int core)
+{
+	mmio_write_64(PLAT_TM_HOLD_BASE + (core * PLAT_TM_HOLD_ENTRY_SIZE), PLAT_TM_HOLD_STATE_GO);
+}
+
+/*
+ * Wait for a released core to pick up its job, withdrawing the request if it never does.
+ * A core that claims the job while it is being withdrawn counts as started, and
+ * then either runs it or declines it, see adrv906x_ddr_mem_test_worker().
+ */
+static bool wait_core_started(unsigned int core)
+{
+	uint64_t timeout = timeout_init_us(JOB_START_TIMEOUT_US);
+
+	while (__atomic_load_n(&jobs[core].state, __ATOMIC_ACQUIRE) == JOB_PENDING) {
+		if (timeout_elapsed(timeout)) {
+			__atomic_store_n(&jobs[core].cancel, 1U, __ATOMIC_RELEASE);
+			dsb();
+			if (__atomic_load_n(&jobs[core].state, __ATOMIC_ACQUIRE) != JOB_PENDING)
+				return true;
+			mmio_write_64(PLAT_TM_HOLD_BASE + (core * PLAT_TM_HOLD_ENTRY_SIZE), PLAT_TM_HOLD_STATE_WAIT);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Wait for a started core to finish, returns false if it declined the job */
+static bool wait_core_done(unsigned int core)
+{
+	uint32_t state;
+
+	for (;;) {
+		state = __atomic_load_n(&jobs[core].state, __ATOMIC_ACQUIRE);
+		if (state == JOB_DONE)
+			return true;
+		if (state == JOB_DECLINED)
+			return false;
+		wfe();
+	}
+}
+
+/*
+ * Runs ddr_simd_mem_test() over [base_addr_ddr, base_addr_ddr + size) split across
+ * num_cores cores (the calling core included), then prints a per-core summary and
+ * the elapsed time. Cores that do not respond have their slice run by the caller.
+ * Leaves the secondary cores in a holding pen inside BL2, so reset afterwards.
+ */
+int adrv906x_ddr_parallel_mem_test(uintptr_t base_addr_ddr, uint64_t size, unsigned int num_cores, uint32_t patterns)
+{
+	unsigned int me = plat_my_core_pos();
+	unsigned int core;
+	unsigned int n;
+	uintptr_t saved_entrypoint;
+	uintptr_t next;
+	uint64_t slice;
+	uint64_t start;
+	uint64_t ticks;
+	uint64_t errors = 0U;
+	bool started[PLATFORM_CORE_COUNT] = { false };
+
+	if (((base_addr_ddr | size) & (DDR_MEM_TEST_ALIGN - 1U)) != 0U || (size == 0U) ||
+	    (num_cores == 0U) || (num_cores > PLATFORM_CORE_COUNT) ||
+	    (patterns == 0U) || ((patterns & ~DDR_MEM_TEST_ALL) != 0U))
+		return -EINVAL;
+
+	slice = (size / num_cores) & ~((uint64_t)DDR_MEM_TEST_ALIGN - 1U);
+
+	/* Secondary cores take equal slices, the calling core takes the rest */
+	next = base_addr_ddr;
+	for (core = 0U, n = 1U; core < PLATFORM_CORE_COUNT; core++) {
+		jobs[core].state = JOB_IDLE;
+		jobs[core].cancel = 0U;
+		jobs[core].size = 0U;
+		if ((core == me) || (n == num_cores) || (slice == 0U))
+			continue;
+		jobs[core].base = next;
+		jobs[core].size = slice;
+		jobs[core].patterns = patterns;
+		next += slice;
+		n++;
+	}
+	jobs[me].base = next;
+	jobs[me].size = (base_addr_ddr + size) - next;
+	jobs[me].patterns = patterns;
+
+	/* disable_mmu_el1() also cleans and invalidates the whole data cache, including the job table */
+	flush_dcache_range(base_addr_ddr, size);
+	disable_mmu_el1();
+
+	start = read_cntpct_el0();
+
+	saved_entrypoint = mmio_read_64(PLAT_TM_ENTRYPOINT);
+	mmio_write_64(PLAT_TM_ENTRYPOINT, (uintptr_t)adrv906x_ddr_mem_test_entry);
+
+	for (core = 0U; core < PLATFORM_CORE_COUNT; core++) {
+		if ((core == me) || (jobs[core].size == 0U))
+			continue;
+		jobs[core].state = JOB_PENDING;
+		release_core(core);
+	}
+	dsb();
+	isb();
+	sev();
+
+	for (core = 0U; core < PLATFORM_CORE_COUNT; core++)
+		if ((core != me) && (jobs[core].size != 0U))
+			started[core] = wait_core_started(core);
+
+	ddr_simd_mem_test(jobs[me].base, jobs[me].size, patterns, &jobs[me].result);
+
+	/* Run the slices of cores that never started here, then wait for the rest */
+	for (core = 0U; core < PLATFORM_CORE_COUNT; core++)
+		if ((core != me) && (jobs[core].size != 0U) && !started[core])
+			ddr_simd_mem_test(jobs[core].base, jobs[core].size, patterns, &jobs[core].result);
+
+	for (core = 0U; core < PLATFORM_CORE_COUNT; core++) {
+		if ((core == me) || !started[core])
+			continue;
+		/* A core that declined its withdrawn job leaves the slice to the primary */
+		if (!wait_core_done(core)) {
+			started[core] = false;
+			ddr_simd_mem_test(jobs[core].base, jobs[core].size, patterns, &jobs[core].result);
+		}
+	}
+
+	ticks = read_cntpct_el0() - start;
+
+	mmio_write_64(PLAT_TM_ENTRYPOINT, saved_entrypoint);
+
+	enable_mmu_el1(0);
+	inv_dcache_range(base_addr_ddr, size);
+	inv_dcache_range((uintptr_t)jobs, sizeof(jobs));
+
+	for (core = 0U; core < PLATFORM_CORE_COUNT; core++) {
+		if (jobs[core].size == 0U)
+			continue;
+		printf("Core %u%s: 0x%lx-0x%lx errors %lu", core, started[core] || (core == me) ? "" : " (ran on primary)",
+		       jobs[core].base, jobs[core].base + jobs[core].size - 1U, jobs[core].result.errors);
+		if (jobs[core].result.errors != 0U)
+			printf(", first at 0x%lx (pattern 0x%x)", jobs[core].result.first_fail, jobs[core].result.first_fail_pattern);
+		printf("\n");
+		errors += jobs[core].result.errors;
+	}
+	printf("Tested %lu MB in %lu ms, %lu failing blocks\n", size >> 20,
+	       (ticks * 1000U) / plat_get_syscnt_freq2(), errors);
+
+	return (errors != 0U) ? ERROR_DDR_EXTENSIVE_MEM_TEST_FAILED : ERROR_DDR_NO_ERROR;
+}
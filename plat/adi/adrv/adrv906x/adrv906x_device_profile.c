@@ -60,6 +60,29 @@ static bool sec_secure_peripherals[PROFILE_SECONDARY_PERIPH_NUM_MAX];
 static bool pri_secure_pins[FW_CONFIG_PIN_NUM_MAX];
 static bool sec_secure_pins[FW_CONFIG_PIN_NUM_MAX];
 
+/*
+ * FW_CONFIG values that are read after boot setup or also written. They are
+ * parsed from FW_CONFIG once, on first use, and the setters write through to
+ * both the cache and FW_CONFIG. Each value keeps the error its read returned,
+ * so a missing property is reported when it is asked for, as before.
+ */
+static struct {
+	bool loaded;
+	char boot_slot[MAX_NODE_NAME_LENGTH];
+	int boot_slot_err;
+	uint32_t nv_ctr;
+	int nv_ctr_err;
+	uint32_t te_rollback_ctr;
+	int te_rollback_ctr_err;
+	uint32_t simulated_enforcement_ctr;
+	int simulated_enforcement_ctr_err;
+	bool error_log_present;
+	uint32_t error_num;
+	int error_num_err;
+	uint32_t reset_cause;
+	int reset_cause_err;
+} fw_config_cache;
+
 static int get_fw_config_node(const char *node_name, bool warn)
 {
 	int node = -1;
@@ -320,6 +343,31 @@ static int set_fw_config_string(const char *node_name, const char *param_name, c
 	return err;
 }
 
+/* Never warns, so it can be reached from the error logging path */
+static void load_fw_config_cache(void)
+{
+	const void *data = NULL;
+
+	if (fw_config_cache.loaded)
+		return;
+
+	fw_config_cache.boot_slot_err = get_fw_config_string("/boot-slot", "slot", &data, false);
+	if (fw_config_cache.boot_slot_err == 0)
+		strlcpy(fw_config_cache.boot_slot, data, sizeof(fw_config_cache.boot_slot));
+
+	fw_config_cache.nv_ctr_err = get_fw_config_uint32("/anti-rollback", "nv-ctr", &fw_config_cache.nv_ctr, false);
+	fw_config_cache.te_rollback_ctr_err = get_fw_config_uint32("/anti-rollback", "te-rollback-ctr", &fw_config_cache.te_rollback_ctr, false);
+	fw_config_cache.simulated_enforcement_ctr_err = get_fw_config_uint32("/anti-rollback", "simulated-enforcement-counter", &fw_config_cache.simulated_enforcement_ctr, false);
+
+	fw_config_cache.error_log_present = fw_config_node_exists("/error-log");
+	fw_config_cache.error_num_err = get_fw_config_uint32("/error-log", "errors", &fw_config_cache.error_num, false);
+
+	fw_config_cache.reset_cause_err = get_fw_config_uint32("/status-reg", "reset-cause", &fw_config_cache.reset_cause, false);
+
+	/* Not cached until FW_CONFIG is usable, so later calls try again */
+	fw_config_cache.loaded = (fw_config_valid == 1);
+}
+
 static void handle_fw_config_read_error(char *param_name, int err)
 {
 	plat_error_message("Unable to get %s from FW_CONFIG %d", param_name, err);
@@ -706,6 +754,9 @@ void plat_dprof_init(void)
 	err = plat_get_secure_partitioning();
 	if (err != 0)
 		handle_fw_config_read_error("Secure partitioning configuration", err);
+
+	fw_config_cache.loaded = false;
+	load_fw_config_cache();
 }
 
 bool plat_get_dual_tile_no_c2c_enabled(void)
@@ -1047,14 +1098,11 @@ int plat_get_mac_setting(uint32_t index, uint8_t **mac)
  */
 const char *plat_get_boot_slot(void)
 {
-	const void *data = NULL;
-	int err = -1;
-
-	err = get_fw_config_string("/boot-slot", "slot", &data, true);
-	if (err != 0)
-		handle_fw_config_read_error("boot slot", err);
+	load_fw_config_cache();
+	if (fw_config_cache.boot_slot_err != 0)
+		handle_fw_config_read_error("boot slot", fw_config_cache.boot_slot_err);
 
-	return (const char *)data;
+	return fw_config_cache.boot_slot;
 }
 
 /*
@@ -1067,6 +1115,9 @@ void plat_set_boot_slot(const char *slot)
 	err = set_fw_config_string("/boot-slot", "slot", slot, true);
 	if (err != 0)
 		handle_fw_config_write_error("boot slot", err);
+
+	strlcpy(fw_config_cache.boot_slot, slot, sizeof(fw_config_cache.boot_slot));
+	fw_config_cache.boot_slot_err = 0;
 }
 
 /*
@@ -1074,14 +1125,11 @@ void plat_set_boot_slot(const char *slot)
  */
 uint32_t plat_get_fw_config_rollback_ctr(void)
 {
-	uint32_t data;
-	int err = -1;
+	load_fw_config_cache();
+	if (fw_config_cache.nv_ctr_err != 0)
+		handle_fw_config_read_error("nv counter", fw_config_cache.nv_ctr_err);
 
-	err = get_fw_config_uint32("/anti-rollback", "nv-ctr", &data, true);
-	if (err != 0)
-		handle_fw_config_read_error("nv counter", err);
-
-	return data;
+	return fw_config_cache.nv_ctr;
 }
 
 /*
@@ -1089,11 +1137,15 @@ uint32_t plat_get_fw_config_rollback_ctr(void)
  */
 void plat_set_fw_config_rollback_ctr(void)
 {
+	uint32_t ctr = plat_get_cert_nv_ctr();
 	int err = -1;
 
-	err = set_fw_config_uint32("/anti-rollback", "nv-ctr", plat_get_cert_nv_ctr(), true);
+	err = set_fw_config_uint32("/anti-rollback", "nv-ctr", ctr, true);
 	if (err != 0)
 		handle_fw_config_write_error("nv counter", err);
+
+	fw_config_cache.nv_ctr = ctr;
+	fw_config_cache.nv_ctr_err = 0;
 }
 
 /*
@@ -1101,14 +1153,11 @@ void plat_set_fw_config_rollback_ctr(void)
  */
 uint32_t plat_get_fw_config_te_rollback_ctr(void)
 {
-	uint32_t data;
-	int err = -1;
+	load_fw_config_cache();
+	if (fw_config_cache.te_rollback_ctr_err != 0)
+		handle_fw_config_read_error("te rollback counter", fw_config_cache.te_rollback_ctr_err);
 
-	err = get_fw_config_uint32("/anti-rollback", "te-rollback-ctr", &data, true);
-	if (err != 0)
-		handle_fw_config_read_error("te rollback counter", err);
-
-	return data;
+	return fw_config_cache.te_rollback_ctr;
 }
 
 /*
@@ -1123,21 +1172,19 @@ void plat_set_fw_config_te_rollback_ctr(uint32_t ctr)
  * This allows us to modify the TE rollback counter from the test framework.
  */
 #if DEBUG == 1
-	uint32_t data;
-	bool found = false;
-	if (fw_config_prop_exists("/anti-rollback", "te-rollback-ctr", &found) == 0) {
-		if (found) {
-			if (get_fw_config_uint32("/anti-rollback", "te-rollback-ctr", &data, false) == 0) {
-				plat_warn_message("TEST_SUPPORT: Using simulated TE anti-rollback counter %d\n", data);
-				ctr = data;
-			}
-		}
+	load_fw_config_cache();
+	if (fw_config_cache.te_rollback_ctr_err == 0) {
+		plat_warn_message("TEST_SUPPORT: Using simulated TE anti-rollback counter %d\n", fw_config_cache.te_rollback_ctr);
+		ctr = fw_config_cache.te_rollback_ctr;
 	}
 #endif
 
 	err = set_fw_config_uint32("/anti-rollback", "te-rollback-ctr", ctr, true);
 	if (err != 0)
 		handle_fw_config_write_error("te rollback counter", err);
+
+	fw_config_cache.te_rollback_ctr = ctr;
+	fw_config_cache.te_rollback_ctr_err = 0;
 }
 
 /*
@@ -1150,16 +1197,11 @@ int plat_get_enforcement_counter(unsigned int *nv_ctr)
  * This allows us to modify the enforcement counter from the test framework.
  */
 #if DEBUG == 1
-	uint32_t value;
-	bool found = false;
-	if (fw_config_prop_exists("/anti-rollback", "simulated-enforcement-counter", &found) == 0) {
-		if (found) {
-			if (get_fw_config_uint32("/anti-rollback", "simulated-enforcement-counter", &value, false) == 0) {
-				plat_warn_message("TEST_SUPPORT: Using simulated enforcement counter %d\n", value);
-				*nv_ctr = value;
-				return 0;
-			}
-		}
+	load_fw_config_cache();
+	if (fw_config_cache.simulated_enforcement_ctr_err == 0) {
+		plat_warn_message("TEST_SUPPORT: Using simulated enforcement counter %d\n", fw_config_cache.simulated_enforcement_ctr);
+		*nv_ctr = fw_config_cache.simulated_enforcement_ctr;
+		return 0;
 	}
 #endif
 
@@ -1172,23 +1214,23 @@ int plat_get_enforcement_counter(unsigned int *nv_ctr)
 void plat_set_fw_config_error_log(char *input)
 {
 	int err = -1;
-	int node = -1;
 	uint32_t error_num = 0;
 	char name[MAX_NODE_NAME_LENGTH];
 
+	load_fw_config_cache();
+
 	/* Check for error log node, else skip logging */
-	node = get_fw_config_node("/error-log", false);
-	if (node < 0) {
+	if (!fw_config_cache.error_log_present) {
 		INFO("Skipping error logging in device tree\n");
 		return;
 	}
 
 	/* Get current number or errors */
-	err = get_fw_config_uint32("/error-log", "errors", &error_num, false);
-	if (err != 0) {
+	if (fw_config_cache.error_num_err != 0) {
 		INFO("Unable to get error-log number of errors\n");
 		return;
 	}
+	error_num = fw_config_cache.error_num;
 
 	/* Get property name for this error */
 	snprintf(name, MAX_NODE_NAME_LENGTH, "error-%d", error_num);
@@ -1202,8 +1244,12 @@ void plat_set_fw_config_error_log(char *input)
 
 	/* Set new number of errors */
 	err = set_fw_config_uint32("/error-log", "errors", error_num + 1, false);
-	if (err != 0)
+	if (err != 0) {
 		INFO("Unable to update log\n");
+		return;
+	}
+
+	fw_config_cache.error_num = error_num + 1;
 }
 
 /*
@@ -1211,15 +1257,12 @@ void plat_set_fw_config_error_log(char *input)
  */
 int plat_get_fw_config_error_num(void)
 {
-	int err = -1;
-	uint32_t error_num;
-
 	/* Get number of errors in error-log */
-	err = get_fw_config_uint32("/error-log", "errors", &error_num, false);
-	if (err < 0)
-		return err;
+	load_fw_config_cache();
+	if (fw_config_cache.error_num_err < 0)
+		return fw_config_cache.error_num_err;
 
-	return (int)error_num;
+	return (int)fw_config_cache.error_num;
 }
 
 /*
@@ -1228,20 +1271,21 @@ int plat_get_fw_config_error_num(void)
 void plat_set_fw_config_reset_cause(uint32_t reset_cause, uint32_t reset_cause_ns)
 {
 	int err = -1;
+	uint32_t cause;
 
-	if (((reset_cause == COLD_BOOT) && (reset_cause_ns == COLD_BOOT)) || ((reset_cause == WARM_RESET) && (reset_cause_ns == WARM_RESET))) {
-		err = set_fw_config_uint32("/status-reg", "reset-cause", reset_cause, true);
-		if (err != 0)
-			handle_fw_config_write_error("reset cause", err);
-	} else if ((reset_cause != COLD_BOOT) && (reset_cause != WARM_RESET)) {
-		err = set_fw_config_uint32("/status-reg", "reset-cause", reset_cause, true);
-		if (err != 0)
-			handle_fw_config_write_error("reset cause", err);
-	} else {
-		err = set_fw_config_uint32("/status-reg", "reset-cause", reset_cause_ns, true);
-		if (err != 0)
-			handle_fw_config_write_error("reset cause", err);
-	}
+	if (((reset_cause == COLD_BOOT) && (reset_cause_ns == COLD_BOOT)) || ((reset_cause == WARM_RESET) && (reset_cause_ns == WARM_RESET)))
+		cause = reset_cause;
+	else if ((reset_cause != COLD_BOOT) && (reset_cause != WARM_RESET))
+		cause = reset_cause;
+	else
+		cause = reset_cause_ns;
+
+	err = set_fw_config_uint32("/status-reg", "reset-cause", cause, true);
+	if (err != 0)
+		handle_fw_config_write_error("reset cause", err);
+
+	fw_config_cache.reset_cause = cause;
+	fw_config_cache.reset_cause_err = 0;
 }
 
 /*
@@ -1249,14 +1293,11 @@ void plat_set_fw_config_reset_cause(uint32_t reset_cause, uint32_t reset_cause_n
  */
 uint32_t plat_get_fw_config_reset_cause(void)
 {
-	int err = -1;
-	uint32_t reset_cause;
-
-	err = get_fw_config_uint32("/status-reg", "reset-cause", &reset_cause, true);
-	if (err != 0)
-		handle_fw_config_read_error("reset cause", err);
+	load_fw_config_cache();
+	if (fw_config_cache.reset_cause_err != 0)
+		handle_fw_config_read_error("reset cause", fw_config_cache.reset_cause_err);
 
-	return reset_cause;
+	return fw_config_cache.reset_cause;
 }
 
 unsigned int plat_get_syscnt_freq2(void)
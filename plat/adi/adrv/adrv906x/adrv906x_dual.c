@@ -8,17 +8,21 @@
 
 #include <arch/aarch64/arch_helpers.h>
 #include <common/debug.h>
+#include <common/tf_crc32.h>
 #include <drivers/adi/adi_te_interface.h>
 #include <drivers/adi/adi_c2cc.h>
 #include <drivers/adi/adrv906x/clk.h>
 #include <drivers/delay_timer.h>
 #include <lib/mmio.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
 
 #include <adrv906x_clkrst_def.h>
 #include <adrv906x_device_profile.h>
 #include <adrv906x_dual.h>
 #include <adrv906x_mmap.h>
 #include <adrv906x_secondary_image.h>
+#include <adrv906x_status_reg.h>
 #include <plat_err.h>
 #include <platform_def.h>
 
@@ -29,6 +33,13 @@
 #define ADI_ADRV906X_C2C_ROSC_DIV 0
 #define ADI_ADRV906X_C2C_DEVCLK_DIV 0
 #define ADI_ADRV906X_C2C_PLL_DIV 0
+#define ADI_ADRV906X_C2C_COARSE_STEP 4                          /* first pass measures every 4th trim */
+
+/* Trims of the last training, kept in a status register per direction for the next boot */
+#define ADRV906X_C2C_TRIM_VALID         (1U << 31)
+#define ADRV906X_C2C_TRIM_MASK          0x3FU
+#define ADRV906X_C2C_TRIM_DELAY_SHIFT(lane)     (8U + (5U * (lane)))
+#define ADRV906X_C2C_TRIM_DELAY_MASK    0x1FU
 
 /* primary-to-secondary training delays */
 #define ADI_ADRV906X_C2C_P2S_RXCMD2TRNTRM 0x15
@@ -68,6 +79,9 @@
 #define SECONDARY_TE_HOST_BOOT_TIMEOUT_US 50000
 #define SECONDARY_TE_HOST_BOOT_ENABLE 0x1048
 
+/* The secondary image is copied, written back and checksummed in chunks of this size */
+#define SECONDARY_IMAGE_CHUNK_SIZE 0x10000
+
 extern void memcpy16(void *dst, const void *src, unsigned int len);
 
 static struct adi_c2cc_training_settings adrv906x_c2c_training_params = {
@@ -110,6 +124,7 @@ static struct adi_c2cc_training_settings adrv906x_c2c_training_params = {
 		.swbcktrm	= ADI_ADRV906X_C2C_S2P_SWBCKTRM,
 		.blktrf		= ADI_ADRV906X_C2C_S2P_BLKTRF,
 	},
+	.coarse_step		= ADI_ADRV906X_C2C_COARSE_STEP,
 };
 
 static struct adi_c2cc_calibration_settings adrv906x_c2c_calibration_params = {
@@ -171,9 +186,51 @@ bool adrv906x_c2c_enable(void)
 	return adi_c2cc_enable();
 }
 
+static uint32_t adrv906x_c2c_encode_trim(uint8_t trim, const uint8_t *delays)
+{
+	uint32_t value = ADRV906X_C2C_TRIM_VALID | (trim & ADRV906X_C2C_TRIM_MASK);
+	unsigned int lane;
+
+	for (lane = 0; lane < ADI_C2C_LANE_COUNT; lane++)
+		value |= (uint32_t)(delays[lane] & ADRV906X_C2C_TRIM_DELAY_MASK) << ADRV906X_C2C_TRIM_DELAY_SHIFT(lane);
+
+	return value;
+}
+
+static bool adrv906x_c2c_decode_trim(uint32_t value, uint8_t *trim, uint8_t *delays)
+{
+	unsigned int lane;
+
+	if ((value & ADRV906X_C2C_TRIM_VALID) == 0U)
+		return false;
+
+	*trim = value & ADRV906X_C2C_TRIM_MASK;
+	for (lane = 0; lane < ADI_C2C_LANE_COUNT; lane++)
+		delays[lane] = (value >> ADRV906X_C2C_TRIM_DELAY_SHIFT(lane)) & ADRV906X_C2C_TRIM_DELAY_MASK;
+
+	return true;
+}
+
 bool adrv906x_c2c_enable_high_speed(void)
 {
-	return adi_c2cc_enable_high_speed(&adrv906x_c2c_training_params);
+	struct adi_c2cc_trim_settings known;
+	struct adi_c2cc_trim_settings trims;
+	bool have_known;
+
+	/* Trims stored by an earlier boot are verified instead of sweeping again */
+	have_known = adrv906x_c2c_decode_trim(adrv906x_rd_priv_status_reg(C2C_TRIM_P2S), &known.p2s_trim, known.p2s_delays) &&
+		     adrv906x_c2c_decode_trim(adrv906x_rd_priv_status_reg(C2C_TRIM_S2P), &known.s2p_trim, known.s2p_delays);
+
+	if (!adi_c2cc_enable_high_speed(&adrv906x_c2c_training_params, have_known ? &known : NULL, &trims)) {
+		adrv906x_wr_priv_status_reg(C2C_TRIM_P2S, 0);
+		adrv906x_wr_priv_status_reg(C2C_TRIM_S2P, 0);
+		return false;
+	}
+
+	adrv906x_wr_priv_status_reg(C2C_TRIM_P2S, adrv906x_c2c_encode_trim(trims.p2s_trim, trims.p2s_delays));
+	adrv906x_wr_priv_status_reg(C2C_TRIM_S2P, adrv906x_c2c_encode_trim(trims.s2p_trim, trims.s2p_delays));
+
+	return true;
 }
 
 bool adrv906x_c2c_enable_hw_bg_cal(void)
@@ -281,17 +338,64 @@ int adrv906x_enable_secondary_tile(void)
 	return 0;
 }
 
+/*
+ * Copies the secondary image across the C2C bridge, then reads it back and
+ * checks it against a CRC32 of the source. Each chunk's cache lines are
+ * written back while the CRC of that chunk is computed, so the write-back
+ * overlaps the checksum instead of being one flush after the whole copy.
+ */
+static int copy_secondary_image(void)
+{
+	uintptr_t dst = (uintptr_t)PLAT_SEC_IMAGE_DST_ADDR;
+	const unsigned char *src = (const unsigned char *)PLAT_SEC_IMAGE_SRC_ADDR;
+	size_t size = PLAT_SEC_IMAGE_SIZE;
+	size_t offset;
+	size_t chunk;
+	uintptr_t line;
+	uint32_t crc = 0U;
+	uint64_t start;
+	uint64_t ticks;
+
+	start = read_cntpct_el0();
+
+	for (offset = 0U; offset < size; offset += chunk) {
+		chunk = MIN(size - offset, (size_t)SECONDARY_IMAGE_CHUNK_SIZE);
+		memcpy16((void *)(dst + offset), src + offset, chunk);
+
+		for (line = (dst + offset) & ~((uintptr_t)CACHE_WRITEBACK_GRANULE - 1U); line < dst + offset + chunk; line += CACHE_WRITEBACK_GRANULE)
+			dccivac(line);
+		crc = tf_crc32(crc, src + offset, chunk);
+		dsbsy();
+	}
+
+	/* The destination is no longer cached, so this reads back what reached the secondary */
+	if (tf_crc32(0U, (const unsigned char *)dst, size) != crc) {
+		plat_error_message("Secondary image CRC mismatch");
+		return -EIO;
+	}
+
+	ticks = read_cntpct_el0() - start;
+	if (ticks != 0U)
+		INFO("Secondary image: %lu bytes in %lu us (%lu KB/s), crc 0x%x\n", size,
+		     (ticks * 1000000U) / plat_get_syscnt_freq2(),
+		     (size * plat_get_syscnt_freq2()) / (ticks * 1024U), crc);
+
+	return 0;
+}
+
 int adrv906x_load_secondary_image(void)
 {
 	plat_sec_boot_cfg_t *boot_cfg_ptr;
+	int err;
 
 	/* Ensure secondary TE is ready for host boot */
 	if (!adi_enclave_is_host_boot_ready(SEC_TE_MAILBOX_BASE))
 		return -ENXIO;
 
 	/* Load the secondary image */
-	memcpy16((void *)PLAT_SEC_IMAGE_DST_ADDR, (void *)PLAT_SEC_IMAGE_SRC_ADDR, PLAT_SEC_IMAGE_SIZE);
-	flush_dcache_range((uintptr_t)PLAT_SEC_IMAGE_DST_ADDR, PLAT_SEC_IMAGE_SIZE);
+	err = copy_secondary_image();
+	if (err != 0)
+		return err;
 
 	if (plat_get_secondary_linux_enabled()) {
 		/* Setup the secondary boot config params */
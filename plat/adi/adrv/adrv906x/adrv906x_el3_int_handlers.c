@@ -10,6 +10,7 @@
 #include <services/sdei.h>
 #endif
 
+#include <arch_helpers.h>
 #include <plat/common/platform.h>
 #include <lib/extensions/ras.h>
 
@@ -27,8 +28,26 @@
 #include <adrv906x_sram.h>
 #include <adrv906x_sdei_events.h>
 
-static interrupt_type_handler_t primary_gpint_interrupt_table[TOTAL_GPINTS] = { NULL };
-static interrupt_type_handler_t secondary_gpint_interrupt_table[TOTAL_GPINTS] = { NULL };
+/* Corrected error interrupts: bursts of up to 16, then at most 10 per second, else masked for 1 s */
+#define CORRECTED_ERR_IRQ_BURST         16
+#define CORRECTED_ERR_IRQ_RATE          10
+#define CORRECTED_ERR_IRQ_BACKOFF_MS    1000
+
+#define GPINT_TILE_PRIMARY      0
+#define GPINT_TILE_SECONDARY    1
+#define GPINT_TILES             2
+
+/* GPINT sources of one tile, indexed like the GPINT status: lower word first, then upper word */
+struct gpint_table {
+	interrupt_type_handler_t handlers[TOTAL_GPINTS];
+	uint64_t handler_mask[2];       /* Sources with an EL3 handler, for the lower and upper word */
+#ifdef PLAT_INTR_STATS
+	uint32_t count[TOTAL_GPINTS];
+	uint16_t latency[TOTAL_GPINTS][GPINT_LATENCY_BUCKETS];
+#endif
+};
+
+static struct gpint_table gpint_tables[GPINT_TILES];
 
 static uint64_t secondary_to_primary_gpint_handler(uint32_t id, uint32_t flags, void *handle, void *cookie)
 {
@@ -68,6 +87,8 @@ static uint64_t secondary_c2c_gpint_handler(uint32_t id, uint32_t flags, void *h
 
 static void plat_request_gpint_intr(uint32_t id, interrupt_type_handler_t handler, bool secondary)
 {
+	struct gpint_table *table = &gpint_tables[secondary ? GPINT_TILE_SECONDARY : GPINT_TILE_PRIMARY];
+
 	/* Validate 'handler' and 'id' parameters */
 	if (id >= TOTAL_GPINTS) {
 		plat_warn_message("Requested GPINT event handler number outside allowed range.");
@@ -79,110 +100,159 @@ static void plat_request_gpint_intr(uint32_t id, interrupt_type_handler_t handle
 		return;
 	}
 
-	if (secondary) {
-		/* Check if a handler has already been registered */
-		if (secondary_gpint_interrupt_table[id]) {
+	/* Check if a handler has already been registered */
+	if (table->handlers[id]) {
+		if (secondary)
 			plat_warn_message("Handler already exists for this secondary GPINT event.");
-			return;
-		}
-
-		secondary_gpint_interrupt_table[id] = handler;
-	} else {
-		/* Check if a handler has already been registered */
-		if (primary_gpint_interrupt_table[id]) {
+		else
 			plat_warn_message("Handler already exists for this primary GPINT event.");
-			return;
-		}
-
-		primary_gpint_interrupt_table[id] = handler;
+		return;
 	}
+
+	table->handlers[id] = handler;
+	table->handler_mask[id / GPINT_INTS_PER_WORD] |= 1ULL << (id % GPINT_INTS_PER_WORD);
 }
 
-static uint64_t gpint_handler(uint32_t id, uint32_t flags, void *handle, void *cookie, uintptr_t gpint_addr)
+#ifdef PLAT_INTR_STATS
+/* Counts a dispatch of source id and files the ticks since the GPINT interrupt was taken */
+static void gpint_record_dispatch(struct gpint_table *table, uint32_t id, uint64_t start)
 {
-#if EL3_EXCEPTION_HANDLING
-	int32_t status = 0;
+	uint64_t ticks = (read_cntpct_el0() - start) >> GPINT_LATENCY_TICK_SHIFT;
+	unsigned int bucket = 0U;
+
+	/* Bucket n > 0 holds [2^(n-1), 2^n) units of 2^GPINT_LATENCY_TICK_SHIFT ticks */
+	if (ticks != 0U)
+		bucket = 64U - (unsigned int)__builtin_clzll(ticks);
+	if (bucket > (GPINT_LATENCY_BUCKETS - 1U))
+		bucket = GPINT_LATENCY_BUCKETS - 1U;
+
+	table->count[id]++;
+	if (table->latency[id][bucket] != UINT16_MAX)
+		table->latency[id][bucket]++;
+}
+#else
+static inline void gpint_record_dispatch(struct gpint_table *table, uint32_t id, uint64_t start)
+{
+}
 #endif
-	uint64_t ret = 0;
-	uint64_t mask = 1;
-	uint32_t gpint = 0;
-	struct gpint_settings settings;
-	interrupt_type_handler_t handler;
 
-	if (id == IRQ_GP_INTERRUPT_SYNC_0 || IRQ_GPINT_INTERRUPT_SECONDARY_TO_PRIMARY)
-		gpint = GPINT0;
-	else if (id == IRQ_GP_INTERRUPT_SYNC_1 || IRQ_C2C_OUT_HW_INTERRUPT_197)
-		gpint = GPINT1;
+/* Forwards the active GPINT sources in pending to the normal world through SDEI */
+static uint64_t gpint_dispatch_nonsecure(struct gpint_table *table, uint64_t pending, uint32_t word, uintptr_t gpint_addr, uint64_t start)
+{
+	uint64_t ret = 0;
+	uint32_t id;
+	int i;
 
-	adrv906x_gpint_get_masked_status(gpint_addr, &settings, gpint);
-	for (int i = 0; i < GPINT_INTS_PER_WORD; i++) {
-		if ((settings.upper_word & mask) >> i) { /*If GPINT event is active*/
-			if (adrv906x_gpint_is_nonsecure(true, mask)) {
 #if EL3_EXCEPTION_HANDLING
-				if (gpint_addr == DIG_CORE_BASE)
-					status = sdei_dispatch_event(GPINT_DEFAULT_SDEI_EVENT + i + GPINT_INTS_PER_WORD);
-				else
-					status = sdei_dispatch_event(SEC_GPINT_DEFAULT_SDEI_EVENT + i + GPINT_INTS_PER_WORD);
-
-				if (status != 0) {
-					if (gpint_addr == DIG_CORE_BASE)
-						plat_error_message("sdei_dispatch_event for event %d returned %d", GPINT_DEFAULT_SDEI_EVENT + i + GPINT_INTS_PER_WORD, status);
-					else
-						plat_error_message("sdei_dispatch_event for event %d returned %d", SEC_GPINT_DEFAULT_SDEI_EVENT + i + GPINT_INTS_PER_WORD, status);
-					ret = 1;
-				}
-#else
-				plat_error_message("Unhandled upper word GPINT interrupt: %d", i);
+	int32_t status;
+	int event;
 #endif
-			} else {
-				if (gpint_addr == DIG_CORE_BASE)
-					handler = primary_gpint_interrupt_table[i + GPINT_INTS_PER_WORD];
-				else
-					handler = secondary_gpint_interrupt_table[i + GPINT_INTS_PER_WORD];
-				if (handler == NULL)
-					plat_error_message("No handler for upper word GPINT event %d", i);
-				else
-					ret = handler(i + GPINT_INTS_PER_WORD, flags, handle, cookie);
-			}
-		}
 
-		if ((settings.lower_word & mask) >> i) { /*If GPINT event is active*/
-			if (adrv906x_gpint_is_nonsecure(false, mask)) {
+	while (pending != 0U) {
+		i = __builtin_ctzll(pending);
+		pending &= pending - 1U;
+		id = (word * GPINT_INTS_PER_WORD) + i;
 #if EL3_EXCEPTION_HANDLING
-				if (gpint_addr == DIG_CORE_BASE)
-					status = sdei_dispatch_event(GPINT_DEFAULT_SDEI_EVENT + i);
-				else
-					status = sdei_dispatch_event(SEC_GPINT_DEFAULT_SDEI_EVENT + i);
-
-				if (status != 0) {
-					if (gpint_addr == DIG_CORE_BASE)
-						plat_error_message("sdei_dispatch_event for event %d returned %d", GPINT_DEFAULT_SDEI_EVENT + i, status);
-					else
-						plat_error_message("sdei_dispatch_event for event %d returned %d", SEC_GPINT_DEFAULT_SDEI_EVENT + i, status);
-					ret = 1;
-				}
+		if (gpint_addr == DIG_CORE_BASE)
+			event = GPINT_DEFAULT_SDEI_EVENT + id;
+		else
+			event = SEC_GPINT_DEFAULT_SDEI_EVENT + id;
+
+		status = sdei_dispatch_event(event);
+		if (status != 0) {
+			plat_error_message("sdei_dispatch_event for event %d returned %d", event, status);
+			ret = 1;
+		}
 #else
-				plat_error_message("Unhandled lower word GPINT interrupt: %d", i);
+		plat_error_message("Unhandled %s word GPINT interrupt: %d", (word == 0U) ? "lower" : "upper", i);
 #endif
-			} else {
-				if (gpint_addr == DIG_CORE_BASE)
-					handler = primary_gpint_interrupt_table[i];
-				else
-					handler = secondary_gpint_interrupt_table[i];
-
-				if (handler == NULL)
-					plat_error_message("No handler for lower word GPINT event %d", i);
-				else
-					ret = handler(i, flags, handle, cookie);
-			}
-		}
+		gpint_record_dispatch(table, id, start);
+	}
 
-		mask = mask << 1;
+	return ret;
+}
+
+/* Runs the EL3 handlers of the active GPINT sources in pending */
+static uint64_t gpint_dispatch_el3(struct gpint_table *table, uint64_t pending, uint32_t word, uint32_t flags, void *handle, void *cookie, uint64_t start)
+{
+	uint64_t ret = 0;
+	uint64_t status;
+	uint64_t unhandled = pending & ~table->handler_mask[word];
+	uint32_t id;
+	int i;
+
+	while (unhandled != 0U) {
+		i = __builtin_ctzll(unhandled);
+		unhandled &= unhandled - 1U;
+		plat_error_message("No handler for %s word GPINT event %d", (word == 0U) ? "lower" : "upper", i);
+	}
+
+	pending &= table->handler_mask[word];
+	while (pending != 0U) {
+		i = __builtin_ctzll(pending);
+		pending &= pending - 1U;
+		id = (word * GPINT_INTS_PER_WORD) + i;
+		status = table->handlers[id](id, flags, handle, cookie);
+		if (status != 0U)
+			ret = status;
+		gpint_record_dispatch(table, id, start);
 	}
 
 	return ret;
 }
 
+static uint64_t gpint_handler(uint32_t id, uint32_t flags, void *handle, void *cookie, uintptr_t gpint_addr)
+{
+#ifdef PLAT_INTR_STATS
+	uint64_t start = read_cntpct_el0();
+#else
+	uint64_t start = 0U;
+#endif
+	uint64_t ret = 0;
+	uint64_t status;
+	uint32_t gpint = GPINT0;
+	struct gpint_settings settings;
+	struct gpint_table *table = &gpint_tables[(gpint_addr == DIG_CORE_BASE) ? GPINT_TILE_PRIMARY : GPINT_TILE_SECONDARY];
+
+	if ((id == IRQ_GP_INTERRUPT_SYNC_1) || (id == IRQ_C2C_OUT_HW_INTERRUPT_197))
+		gpint = GPINT1;
+
+	adrv906x_gpint_get_masked_status(gpint_addr, &settings, gpint);
+
+	/* Walk only the active sources, routed either to the normal world or to EL3 */
+	status = gpint_dispatch_nonsecure(table, settings.lower_word & adrv906x_gpint_get_routing(false), 0U, gpint_addr, start);
+	if (status != 0U)
+		ret = status;
+	status = gpint_dispatch_el3(table, settings.lower_word & ~adrv906x_gpint_get_routing(false), 0U, flags, handle, cookie, start);
+	if (status != 0U)
+		ret = status;
+	status = gpint_dispatch_nonsecure(table, settings.upper_word & adrv906x_gpint_get_routing(true), 1U, gpint_addr, start);
+	if (status != 0U)
+		ret = status;
+	status = gpint_dispatch_el3(table, settings.upper_word & ~adrv906x_gpint_get_routing(true), 1U, flags, handle, cookie, start);
+	if (status != 0U)
+		ret = status;
+
+	return ret;
+}
+
+#ifdef PLAT_INTR_STATS
+int adrv906x_gpint_get_stats(uint32_t id, bool secondary, uint32_t *count, uint16_t latency[GPINT_LATENCY_BUCKETS])
+{
+	struct gpint_table *table = &gpint_tables[secondary ? GPINT_TILE_SECONDARY : GPINT_TILE_PRIMARY];
+	unsigned int i;
+
+	if (id >= TOTAL_GPINTS)
+		return -EINVAL;
+
+	*count = table->count[id];
+	for (i = 0U; i < GPINT_LATENCY_BUCKETS; i++)
+		latency[i] = table->latency[id][i];
+
+	return 0;
+}
+#endif
+
 static uint64_t primary_gpint_handler(uint32_t id, uint32_t flags, void *handle, void *cookie)
 {
 	return gpint_handler(id, flags, handle, cookie, DIG_CORE_BASE);
@@ -397,26 +467,34 @@ static uint64_t c2c_fault_handler(uint32_t id, uint32_t flags, void *handle, voi
 	return -1;
 }
 
+/* Registers an EL3 handler for a corrected error interrupt, rate limited so error storms cannot monopolize a core */
+static void request_corrected_err_intr(uint32_t id, interrupt_type_handler_t handler)
+{
+	plat_request_intr_type_el3(id, handler);
+	if (plat_throttle_intr_type_el3(id, CORRECTED_ERR_IRQ_BURST, CORRECTED_ERR_IRQ_RATE, CORRECTED_ERR_IRQ_BACKOFF_MS) != 0)
+		plat_warn_message("Unable to rate limit interrupt %u", id);
+}
+
 void plat_assign_interrupt_handlers(void)
 {
 	/* Set up handlers for GPINT0 */
 	plat_request_intr_type_el3(IRQ_GP_INTERRUPT_SYNC_0, primary_gpint_handler);
 
 	/* Handlers for cache ECC warnings and errors */
-	plat_request_intr_type_el3(IRQ_NFAULTIRQ_0, cache_l3_fault_handler);
-	plat_request_intr_type_el3(IRQ_NFAULTIRQ_1, cache_l1l2_fault_handler);
-	plat_request_intr_type_el3(IRQ_NFAULTIRQ_2, cache_l1l2_fault_handler);
-	plat_request_intr_type_el3(IRQ_NFAULTIRQ_3, cache_l1l2_fault_handler);
-	plat_request_intr_type_el3(IRQ_NFAULTIRQ_4, cache_l1l2_fault_handler);
+	request_corrected_err_intr(IRQ_NFAULTIRQ_0, cache_l3_fault_handler);
+	request_corrected_err_intr(IRQ_NFAULTIRQ_1, cache_l1l2_fault_handler);
+	request_corrected_err_intr(IRQ_NFAULTIRQ_2, cache_l1l2_fault_handler);
+	request_corrected_err_intr(IRQ_NFAULTIRQ_3, cache_l1l2_fault_handler);
+	request_corrected_err_intr(IRQ_NFAULTIRQ_4, cache_l1l2_fault_handler);
 
 	/* Handlers for L4 cache warnings and errors */
-	plat_request_intr_type_el3(IRQ_L4_ECC_WRN_INTR_0, l4_warning_handler);
-	plat_request_intr_type_el3(IRQ_L4_ECC_WRN_INTR_1, l4_warning_handler);
-	plat_request_intr_type_el3(IRQ_L4_ECC_WRN_INTR_2, l4_warning_handler);
+	request_corrected_err_intr(IRQ_L4_ECC_WRN_INTR_0, l4_warning_handler);
+	request_corrected_err_intr(IRQ_L4_ECC_WRN_INTR_1, l4_warning_handler);
+	request_corrected_err_intr(IRQ_L4_ECC_WRN_INTR_2, l4_warning_handler);
 
 	/* Handlers for DDR error and warning events */
-	plat_request_intr_type_el3(IRQ_ECC_CORRECTED_ERR_INTR, ddr_ecc_corrected_err_handler);
-	plat_request_intr_type_el3(IRQ_ECC_CORRECTED_ERR_INTR_FAULT, ddr_ecc_corrected_err_handler);
+	request_corrected_err_intr(IRQ_ECC_CORRECTED_ERR_INTR, ddr_ecc_corrected_err_handler);
+	request_corrected_err_intr(IRQ_ECC_CORRECTED_ERR_INTR_FAULT, ddr_ecc_corrected_err_handler);
 	plat_request_intr_type_el3(IRQ_O_ECC_UNCORRECTED_ERR_INTR, ddr_ecc_uncorrected_err_handler);
 	plat_request_intr_type_el3(IRQ_O_ECC_UNCORRECTED_ERR_INTR_FAULT, ddr_ecc_uncorrected_err_handler);
 	plat_request_intr_type_el3(IRQ_O_ECC_AP_ERR_INTR, ddr_ap_err_handler);
@@ -427,9 +505,9 @@ void plat_assign_interrupt_handlers(void)
 	plat_request_intr_type_el3(IRQ_O_DWC_DDRPHY_INT_N, ddr_phy_err_handler);
 
 	/* Handlers for C2C error and warning events */
-	plat_request_intr_type_el3(IRQ_C2C_NON_CRIT_INTR, c2c_fault_handler);
+	request_corrected_err_intr(IRQ_C2C_NON_CRIT_INTR, c2c_fault_handler);
 	plat_request_intr_type_el3(IRQ_C2C_CRIT_INTR, c2c_fault_handler);
-	plat_request_intr_type_el3(IRQ_C2C_OUT_HW_INTERRUPT_171, c2c_fault_handler);
+	request_corrected_err_intr(IRQ_C2C_OUT_HW_INTERRUPT_171, c2c_fault_handler);
 
 	/* Set up handlers for GPINT events */
 	plat_request_gpint_intr(CLKPLL_PLL_LOCKED_SYNC, primary_clkpll_unlock_gpint_handler, false);
@@ -445,9 +523,9 @@ void plat_assign_interrupt_handlers(void)
 		plat_request_intr_type_el3(IRQ_C2C_OUT_HW_INTERRUPT_21, l4_error_handler);
 		plat_request_intr_type_el3(IRQ_C2C_OUT_HW_INTERRUPT_24, l4_error_handler);
 
-		plat_request_intr_type_el3(IRQ_C2C_OUT_HW_INTERRUPT_17, l4_warning_handler);
-		plat_request_intr_type_el3(IRQ_C2C_OUT_HW_INTERRUPT_20, l4_warning_handler);
-		plat_request_intr_type_el3(IRQ_C2C_OUT_HW_INTERRUPT_23, l4_warning_handler);
+		request_corrected_err_intr(IRQ_C2C_OUT_HW_INTERRUPT_17, l4_warning_handler);
+		request_corrected_err_intr(IRQ_C2C_OUT_HW_INTERRUPT_20, l4_warning_handler);
+		request_corrected_err_intr(IRQ_C2C_OUT_HW_INTERRUPT_23, l4_warning_handler);
 
 		/* Set up handlers for GPINT events */
 		plat_request_gpint_intr(CLKPLL_PLL_LOCKED_SYNC, secondary_clkpll_unlock_gpint_handler, true);
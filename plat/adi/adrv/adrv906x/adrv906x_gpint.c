@@ -323,6 +323,12 @@ bool adrv906x_gpint_is_nonsecure(bool upper_word, uint64_t mask)
 	}
 }
 
+/* Returns the sources of the upper or lower word that are routed to the normal world */
+uint64_t adrv906x_gpint_get_routing(bool upper_word)
+{
+	return upper_word ? gp_settings.upper_word_route_nonsecure : gp_settings.lower_word_route_nonsecure;
+}
+
 void adrv906x_gpint_set_routing(struct gpint_settings *settings)
 {
 	gp_settings.upper_word_route_nonsecure = settings->upper_word_route_nonsecure;
@@ -87,9 +87,14 @@
 #define OTP_PRODUCT_ID_BITM             0xFF000000
 
 
+/* The rollback counters and MAC addresses are read several times during boot, keep them in SRAM */
+#define OTP_SHADOW_BASE                 OTP_OPEN_ZONE_BASE
+#define OTP_SHADOW_NUM_REGS             (OTP_MAC_ADDRESSES_END - OTP_OPEN_ZONE_BASE)
+
 /*--------------------------------------------------------
  * GLOBALS
  *------------------------------------------------------*/
+static uint32_t otp_shadow[OTP_SHADOW_NUM_REGS];
 
 /*--------------------------------------------------------
  * INTERNAL FUNCTIONS PROTOTYPES
@@ -267,6 +272,13 @@ void adrv906x_otp_init_driver(void)
 	otp_init_driver(dap_settings, pmc_settings);
 }
 
+void adrv906x_otp_init_shadow(const uintptr_t mem_ctrl_base)
+{
+	/* Both are read with ECC disabled, so the shadow copy is too */
+	if (otp_shadow_init(mem_ctrl_base, OTP_SHADOW_BASE, otp_shadow, OTP_SHADOW_NUM_REGS, OTP_ECC_OFF) != ADI_OTP_SUCCESS)
+		plat_warn_message("%s: Cannot read OTP open zone, reading it on demand", __func__);
+}
+
 int adrv906x_otp_get_product_id(const uintptr_t mem_ctrl_base, uint8_t *id)
 {
 	uint32_t data;
@@ -32,11 +32,8 @@
 /**
  * This function returns true if pad_pin_num is secure_world access only
  */
-static bool plat_pin_is_secure(bool is_primary, uint32_t pad_pin_num)
+static bool plat_pin_in_secure_list(const bool *pin_list, int len, uint32_t pad_pin_num)
 {
-	int len;
-	bool *pin_list = plat_get_secure_pins(is_primary, &len);
-
 	if (pad_pin_num < len)
 		return pin_list[pad_pin_num];
 
@@ -45,22 +42,19 @@ static bool plat_pin_is_secure(bool is_primary, uint32_t pad_pin_num)
 	return false;
 }
 
-/** Added settings to prohibit optimization which     */
-#pragma GCC push_options
-#pragma GCC optimize ("O0")
+static bool plat_pin_is_secure(bool is_primary, uint32_t pad_pin_num)
+{
+	int len;
+	bool *pin_list = plat_get_secure_pins(is_primary, &len);
+
+	return plat_pin_in_secure_list(pin_list, len, pad_pin_num);
+}
 
 /**
- *	Pinmux set function, returns true if set command completes successfully, else false
- *		all configuration parameters within the settings parameter, secure_access = true
- * 		when request originates from secure_world.
- *
+ * This function returns true if base_addr is a pinctrl block that can be used
  */
-bool plat_secure_pinctrl_set(const plat_pinctrl_settings settings, const bool secure_access, uintptr_t base_addr)
+static bool plat_pinctrl_base_is_valid(uintptr_t base_addr)
 {
-	adrv906x_cmos_pad_ds_t adrv906x_drive_strength = (adrv906x_cmos_pad_ds_t)(settings.drive_strength & ADRV906X_PINCTRL_x4_DRIVE_STRENGTH_MASK);
-	adrv906x_pad_pupd_t pull_direction;
-	bool is_primary = (base_addr == PINCTRL_BASE);
-
 	if (base_addr == SEC_PINCTRL_BASE) {
 		if (!plat_get_dual_tile_enabled()) {
 			/* Can only try to set up secondary pinctrl if secondary actually exists */
@@ -73,53 +67,64 @@ bool plat_secure_pinctrl_set(const plat_pinctrl_settings settings, const bool se
 		return false;
 	}
 
-	if (settings.pullup == true)
-		pull_direction = PULL_UP;
-	else
-		pull_direction = PULL_DOWN;
+	return true;
+}
 
+/**
+ * This function returns true if the pin and source mux in settings can be configured
+ */
+static bool plat_pinctrl_settings_are_valid(const plat_pinctrl_settings *settings)
+{
 	/*
 	 * Verify the pin# is in range
 	 */
-	if (settings.pin_pad >= ADRV906X_PIN_COUNT && !ADRV906X_IS_DIO_PIN(settings.pin_pad)) {
-		plat_runtime_warn_message("PINCTRL: Request Pin # = %d out of range ", settings.pin_pad);
+	if (settings->pin_pad >= ADRV906X_PIN_COUNT && !ADRV906X_IS_DIO_PIN(settings->pin_pad)) {
+		plat_runtime_warn_message("PINCTRL: Request Pin # = %d out of range ", settings->pin_pad);
 		return false;
 	}
 
 	/*
 	 * Verify that non-dedicated IO have a valid src mux specified
 	 */
-	if (!ADRV906X_IS_DIO_PIN(settings.pin_pad) && settings.src_mux >= ADRV906X_PINMUX_SRC_PER_PIN) {
-		plat_runtime_warn_message("PINCTRL: Invalid source mux value: %u specified for pin# %u", settings.src_mux, settings.pin_pad);
+	if (!ADRV906X_IS_DIO_PIN(settings->pin_pad) && settings->src_mux >= ADRV906X_PINMUX_SRC_PER_PIN) {
+		plat_runtime_warn_message("PINCTRL: Invalid source mux value: %u specified for pin# %u", settings->src_mux, settings->pin_pad);
 		return false;
 	}
 
 	/*
 	 * Verify the incoming pin_source is withing range
 	 */
-	if (settings.src_mux >= ADRV906X_PINMUX_SRC_PER_PIN && settings.src_mux != ADRV906X_DIO_MUX_NONE) {
-		plat_runtime_warn_message("PINCTRL: Invalid source mux value: %u ", settings.src_mux);
+	if (settings->src_mux >= ADRV906X_PINMUX_SRC_PER_PIN && settings->src_mux != ADRV906X_DIO_MUX_NONE) {
+		plat_runtime_warn_message("PINCTRL: Invalid source mux value: %u ", settings->src_mux);
 		return false;
 	}
 
 	/*
 	 * Verify that non-dedicated requested source is valid and not NO_SIGNAL
 	 */
-	if (!ADRV906X_IS_DIO_PIN(settings.pin_pad)) {
-		if ((pinmux_config[settings.pin_pad][settings.src_mux] >= ADRV906X_PINMUX_NUM_SRCS) || (pinmux_config[settings.pin_pad][settings.src_mux] == NO_SIGNAL)) {
-			plat_runtime_warn_message("PINCTRL: Invalid source %d requested ", pinmux_config[settings.pin_pad][settings.src_mux]);
+	if (!ADRV906X_IS_DIO_PIN(settings->pin_pad)) {
+		if ((pinmux_config[settings->pin_pad][settings->src_mux] >= ADRV906X_PINMUX_NUM_SRCS) || (pinmux_config[settings->pin_pad][settings->src_mux] == NO_SIGNAL)) {
+			plat_runtime_warn_message("PINCTRL: Invalid source %d requested ", pinmux_config[settings->pin_pad][settings->src_mux]);
 			return false;
 		}
 	}
 
-	/*
-	 * Prohibit normal world from configuring secure IO
-	 */
-	if (!secure_access && plat_pin_is_secure(is_primary, settings.pin_pad)) {
-		plat_runtime_warn_message("PINCTRL: Normal World request to configure secure %sPin # = %d ",
-					  is_primary ? "" : "secondary-", settings.pin_pad);
-		return false;
-	}
+	return true;
+}
+
+/**
+ * Writes validated settings to the pad and pinmux registers
+ */
+static void plat_pinctrl_apply(const plat_pinctrl_settings *settings, uintptr_t base_addr)
+{
+	adrv906x_cmos_pad_ds_t adrv906x_drive_strength = (adrv906x_cmos_pad_ds_t)(settings->drive_strength & ADRV906X_PINCTRL_x4_DRIVE_STRENGTH_MASK);
+	adrv906x_pad_pupd_t pull_direction;
+
+	if (settings->pullup == true)
+		pull_direction = PULL_UP;
+	else
+		pull_direction = PULL_DOWN;
+
 	/*
 	 * Perform the request
 	 * per hardware (Sonu John's email), it is preferred that we configure PAD settings prior to the pinmux configuration.
@@ -128,33 +133,108 @@ bool plat_secure_pinctrl_set(const plat_pinctrl_settings settings, const bool se
 	/*
 	 * Set the drive strength
 	 */
-	pinctrl_set_pad_drv_strn(base_addr, settings.pin_pad, adrv906x_drive_strength);
+	pinctrl_set_pad_drv_strn(base_addr, settings->pin_pad, adrv906x_drive_strength);
 
 	/*
 	 * Setup Schmitt Trigger
 	 */
-	pinctrl_set_pad_st_en(base_addr, settings.pin_pad, settings.schmitt_trigger_enable);
+	pinctrl_set_pad_st_en(base_addr, settings->pin_pad, settings->schmitt_trigger_enable);
 
 	/*
 	 * If PULL enablement, set the state here
 	 */
-	if (settings.pullup_pulldown_enablement == true)
-		pinctrl_set_pad_ps(base_addr, settings.pin_pad, pull_direction);
+	if (settings->pullup_pulldown_enablement == true)
+		pinctrl_set_pad_ps(base_addr, settings->pin_pad, pull_direction);
 
 	/*
 	 * Set PUll enablement
 	 */
-	pinctrl_set_pad_pen(base_addr, settings.pin_pad, settings.pullup_pulldown_enablement);
+	pinctrl_set_pad_pen(base_addr, settings->pin_pad, settings->pullup_pulldown_enablement);
 
 	/*
 	 * Setup the pinmux sel / pinmux source, for non-dedicated IO
 	 */
-	if (!ADRV906X_IS_DIO_PIN(settings.pin_pad))
-		pinctrl_set_pinmux_sel(base_addr, settings.pin_pad, settings.src_mux);
+	if (!ADRV906X_IS_DIO_PIN(settings->pin_pad))
+		pinctrl_set_pinmux_sel(base_addr, settings->pin_pad, settings->src_mux);
+}
+
+/**
+ *	Pinmux set function, returns true if set command completes successfully, else false
+ *		all configuration parameters within the settings parameter, secure_access = true
+ * 		when request originates from secure_world.
+ *
+ */
+bool plat_secure_pinctrl_set(const plat_pinctrl_settings settings, const bool secure_access, uintptr_t base_addr)
+{
+	bool is_primary = (base_addr == PINCTRL_BASE);
+
+	if (!plat_pinctrl_base_is_valid(base_addr))
+		return false;
+
+	if (!plat_pinctrl_settings_are_valid(&settings))
+		return false;
+
+	/*
+	 * Prohibit normal world from configuring secure IO
+	 */
+	if (!secure_access && plat_pin_is_secure(is_primary, settings.pin_pad)) {
+		plat_runtime_warn_message("PINCTRL: Normal World request to configure secure %sPin # = %d ",
+					  is_primary ? "" : "secondary-", settings.pin_pad);
+		return false;
+	}
+
+	plat_pinctrl_apply(&settings, base_addr);
 
 	return true;
 }
 
+/**
+ *	Pinmux batch set function, checks the base address and fetches the
+ *		secure pin list once, then validates and applies each entry.
+ *		applied[i] reports whether settings[i] was applied. Returns
+ *		true if every entry was applied.
+ *
+ */
+bool plat_secure_pinctrl_set_batch(const plat_pinctrl_settings settings[], bool applied[], const size_t count, const bool secure_access, uintptr_t base_addr)
+{
+	bool is_primary = (base_addr == PINCTRL_BASE);
+	bool *secure_pins = NULL;
+	bool all_applied = true;
+	int len = 0;
+	size_t i;
+
+	for (i = 0U; i < count; i++)
+		applied[i] = false;
+
+	if (!plat_pinctrl_base_is_valid(base_addr))
+		return false;
+
+	if (!secure_access)
+		secure_pins = plat_get_secure_pins(is_primary, &len);
+
+	for (i = 0U; i < count; i++) {
+		if (!plat_pinctrl_settings_are_valid(&settings[i])) {
+			all_applied = false;
+			continue;
+		}
+
+		/*
+		 * Prohibit normal world from configuring secure IO
+		 */
+		if (!secure_access && plat_pin_in_secure_list(secure_pins, len, settings[i].pin_pad)) {
+			plat_runtime_warn_message("PINCTRL: Normal World request to configure secure %sPin # = %d ",
+						  is_primary ? "" : "secondary-", settings[i].pin_pad);
+			all_applied = false;
+			continue;
+		}
+
+		plat_pinctrl_apply(&settings[i], base_addr);
+		applied[i] = true;
+	}
+
+	return all_applied;
+}
+
 /**
  *	Pinmux get function, returns true if get command completes successfully, else false
  *		all configuration parameters within the settings parameter, secure_access = true
@@ -286,4 +366,3 @@ int plat_pinctrl_gpio_to_pin(unsigned int gpio, bool secure, uintptr_t base_addr
 	return -1;
 }
 
-#pragma GCC pop_options
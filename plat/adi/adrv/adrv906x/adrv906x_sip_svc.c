@@ -7,9 +7,48 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 
+#include <adrv906x_ddr.h>
+#include <adrv906x_el3_int_handlers.h>
 #include <adrv906x_sip_svc.h>
+#include <adrv906x_status_reg.h>
 #include <plat_err.h>
 
+/* Returns whether the boot-time DDR BIST ran, and its correctable and uncorrectable ECC error counts */
+static uintptr_t ddr_bist_smc_handler(void *handle)
+{
+	uint32_t status = adrv906x_rd_priv_status_reg(DDR_BIST);
+
+	if ((status & DDR_BIST_STATUS_DONE) == 0U)
+		SMC_RET4(handle, SMC_OK, 0, 0, 0);
+
+	SMC_RET4(handle, SMC_OK, 1,
+		 (status & DDR_BIST_STATUS_CORR_MASK) >> DDR_BIST_STATUS_CORR_SHIFT,
+		 (status & DDR_BIST_STATUS_UNCORR_MASK) >> DDR_BIST_STATUS_UNCORR_SHIFT);
+}
+
+#ifdef PLAT_INTR_STATS
+/*
+ * Returns the dispatch count of GPINT source x1 (x2 = 1 for the secondary tile),
+ * and its dispatch latency histogram in generic timer ticks with four 16-bit
+ * buckets per register, lowest first
+ */
+static uintptr_t gpint_stats_smc_handler(void *handle, u_register_t x1, u_register_t x2)
+{
+	uint16_t latency[GPINT_LATENCY_BUCKETS];
+	uint64_t hist[2] = { 0U, 0U };
+	uint32_t count;
+	unsigned int i;
+
+	if (adrv906x_gpint_get_stats((uint32_t)x1, x2 != 0U, &count, latency) != 0)
+		SMC_RET1(handle, SMC_UNK);
+
+	for (i = 0U; i < GPINT_LATENCY_BUCKETS; i++)
+		hist[i / 4U] |= (uint64_t)latency[i] << (16U * (i % 4U));
+
+	SMC_RET4(handle, SMC_OK, count, hist[0], hist[1]);
+}
+#endif
+
 uintptr_t plat_smc_handler(unsigned int smc_fid, u_register_t x1, u_register_t x2, u_register_t x3, u_register_t x4, void *cookie, void *handle, u_register_t flags)
 {
 	switch (smc_fid) {
@@ -17,6 +56,14 @@ uintptr_t plat_smc_handler(unsigned int smc_fid, u_register_t x1, u_register_t x
 	case ADRV906X_SIP_SVC_TEST:
 		SMC_RET1(handle, 0xDEADBEEF);
 
+	case ADRV906X_SIP_SVC_DDR_BIST:
+		return ddr_bist_smc_handler(handle);
+
+#ifdef PLAT_INTR_STATS
+	case ADRV906X_SIP_SVC_GPINT_STATS:
+		return gpint_stats_smc_handler(handle, x1, x2);
+#endif
+
 	default:
 		plat_runtime_warn_message("Unimplemented SiP Service Call: 0x%x ", smc_fid);
 		SMC_RET1(handle, SMC_UNK);
@@ -26,6 +26,9 @@
 #define STARTING_SLOT_OFFSET            8
 #define LAST_SLOT_OFFSET                12
 
+/* TF-A private status registers, see adrv906x_status_reg.h */
+#define PRIV_STATUS_REG_OFFSET          0x100
+
 /* Read from specified boot status register */
 uint32_t plat_rd_status_reg(plat_status_reg_id_t reg)
 {
@@ -82,6 +85,29 @@ bool plat_wr_status_reg(plat_status_reg_id_t reg, uint32_t value)
 	return true;
 }
 
+/* Read from specified TF-A private status register */
+uint32_t adrv906x_rd_priv_status_reg(adrv906x_priv_status_reg_id_t reg)
+{
+	if (reg >= PRIV_STATUS_REG_COUNT) {
+		plat_warn_message("Not a valid status register");
+		return 0;
+	}
+
+	return mmio_read_32(A55_SYS_CFG + SCRATCH + PRIV_STATUS_REG_OFFSET + (reg * 4U));
+}
+
+/* Write value to specified TF-A private status register */
+bool adrv906x_wr_priv_status_reg(adrv906x_priv_status_reg_id_t reg, uint32_t value)
+{
+	if (reg >= PRIV_STATUS_REG_COUNT) {
+		plat_warn_message("Not a valid status register");
+		return false;
+	}
+
+	mmio_write_32(A55_SYS_CFG + SCRATCH + PRIV_STATUS_REG_OFFSET + (reg * 4U), value);
+	return true;
+}
+
 /* Get the reset cause string */
 const char *plat_get_reset_cause_str(reset_cause_t cause)
 {
@@ -9,11 +9,21 @@
 
 #include <drivers/adi/adrv906x/ddr/ddr.h>
 
+/* DDR_BIST status register, written by BL2 after the boot-time scrubber BIST and reported by the SiP service */
+#define DDR_BIST_STATUS_DONE            (1U << 31)
+#define DDR_BIST_STATUS_UNCORR_MASK     0x7FFF0000U
+#define DDR_BIST_STATUS_UNCORR_SHIFT    16
+#define DDR_BIST_STATUS_CORR_MASK       0x0000FFFFU
+#define DDR_BIST_STATUS_CORR_SHIFT      0
+
 int adrv906x_ddr_init(void);
 int adrv906x_ddr_ate_test(uintptr_t base_addr_phy, uintptr_t base_addr_adi_interface, uintptr_t base_addr_clk);
+int adrv906x_ddr_bist(const uint32_t *patterns, unsigned int num_patterns, ddr_bist_result_t *result);
+void adrv906x_ddr_boot_bist(void);
 
 /* Debug-only functions */
 int adrv906x_ddr_extensive_mem_test(uintptr_t base_addr_ddr, uint32_t size);
+int adrv906x_ddr_parallel_mem_test(uintptr_t base_addr_ddr, uint64_t size, unsigned int num_cores, uint32_t patterns);
 int adrv906x_ddr_mem_test(uintptr_t base_addr_ddr, uint32_t size, bool restore);
 int adrv906x_ddr_custom_training_test(uintptr_t base_addr_phy, uint16_t sequence_ctrl, int train_2d);
 void adrv906x_ddr_set_custom_parameters(ddr_custom_values_t *values);
@@ -7,6 +7,20 @@
 #ifndef ADRV906X_EL3_INT_HANDLERS_H
 #define ADRV906X_EL3_INT_HANDLERS_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 void plat_assign_interrupt_handlers(void);
 
+#ifdef PLAT_INTR_STATS
+/*
+ * GPINT dispatch latency histogram, in generic timer ticks: < 32, < 64,
+ * < 128 ... < 2048, and >= 2048 ticks
+ */
+#define GPINT_LATENCY_BUCKETS           8U
+#define GPINT_LATENCY_TICK_SHIFT        5U
+
+int adrv906x_gpint_get_stats(uint32_t id, bool secondary, uint32_t *count, uint16_t latency[GPINT_LATENCY_BUCKETS]);
+#endif
+
 #endif /* ADRV906X_EL3_INT_HANDLERS_H */
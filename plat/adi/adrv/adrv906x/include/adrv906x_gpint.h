@@ -31,6 +31,7 @@ void adrv906x_gpint_enable(uintptr_t gpint_base_addr, uint32_t gpint, struct gpi
 void adrv906x_gpint_disable(uintptr_t gpint_base_addr, uint32_t gpint, struct gpint_settings *settings);
 void adrv906x_gpint_warm_reset_enable(void);
 bool adrv906x_gpint_is_nonsecure(bool upper_word, uint64_t mask);
+uint64_t adrv906x_gpint_get_routing(bool upper_word);
 void adrv906x_gpint_set_routing(struct gpint_settings *settings);
 void adrv906x_gpint_print_status(const struct gpint_settings *settings);
 
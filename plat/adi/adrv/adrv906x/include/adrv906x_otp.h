@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 void adrv906x_otp_init_driver(void);
+void adrv906x_otp_init_shadow(const uintptr_t mem_ctrl_base);
 int adrv906x_otp_get_product_id(const uintptr_t mem_ctrl_base, uint8_t *id);
 int adrv906x_otp_get_rollback_counter(const uintptr_t mem_ctrl_base, unsigned int *nv_ctr);
 int adrv906x_otp_set_rollback_counter(const uintptr_t mem_ctrl_base, unsigned int nv_ctr);
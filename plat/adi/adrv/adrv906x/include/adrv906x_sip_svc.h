@@ -12,6 +12,8 @@
 /* SMC function IDs for SiP Service queries */
 /* TODO: Remove this when real functions are defined */
 #define ADRV906X_SIP_SVC_TEST     U(0xC2000100)
+#define ADRV906X_SIP_SVC_DDR_BIST U(0xC2000101)
+#define ADRV906X_SIP_SVC_GPINT_STATS U(0xC2000102)
 
 /* If the common function ID range has moved, we need to know about it */
 CASSERT(PLAT_SIP_SVC_MAX == U(0xC20000FF), plat_max_sip_has_moved);
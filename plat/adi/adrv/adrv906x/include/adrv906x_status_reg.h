@@ -7,8 +7,26 @@
 #ifndef __ADI_ADRV906X_STATUS_REG_H__
 #define __ADI_ADRV906X_STATUS_REG_H__
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #define SCRATCH 0x40000
 #define SCRATCH_NS      0x80000
 
+/*
+ * Status registers used only by TF-A. They live in a separate scratch range,
+ * away from the plat_status_reg_id_t registers shared with U-Boot, Linux and
+ * OP-TEE, and are not part of that contract.
+ */
+typedef enum {
+	EMMC_TUNING,
+	DDR_BIST,
+	C2C_TRIM_P2S,
+	C2C_TRIM_S2P,
+	PRIV_STATUS_REG_COUNT
+} adrv906x_priv_status_reg_id_t;
+
+uint32_t adrv906x_rd_priv_status_reg(adrv906x_priv_status_reg_id_t reg);
+bool adrv906x_wr_priv_status_reg(adrv906x_priv_status_reg_id_t reg, uint32_t value);
 
 #endif /* __ADI_ADRV906X_STATUS_REG_H__ */
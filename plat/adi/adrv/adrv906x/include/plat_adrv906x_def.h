@@ -65,6 +65,15 @@
 #define SEC_NS_SRAM_BASE                   UL(0x04100000)
 #define SEC_NS_SRAM_SIZE                   UL(0x00400000)                       /* 4 MB */
 
+/*
+ * Memory the Tiny Enclave can access in place, mailbox buffers in this
+ * region are passed to it without copying. Only the secure SRAM above the
+ * NS window, where the BL images run, so the normal world cannot change a
+ * buffer between its validation and its use by the TE.
+ */
+#define PLAT_TE_SHARED_MEM_BASE            (NS_SRAM_BASE + NS_SRAM_SIZE)
+#define PLAT_TE_SHARED_MEM_SIZE            (SRAM_BASE + SRAM_SIZE - PLAT_TE_SHARED_MEM_BASE)
+
 /*
  * Device addresses
  */
@@ -98,6 +107,9 @@
 #define CACHE_WRITEBACK_SHIFT           6
 #define CACHE_WRITEBACK_GRANULE         (1 << CACHE_WRITEBACK_SHIFT)
 
+/* Stack for each secondary core running the parallel DDR memory test (BL2 CLI) */
+#define DDR_MEM_TEST_STACK_SIZE         0x400
+
 /*
  * Max MTD Devices
  */
@@ -125,6 +137,7 @@
  * EMMC defines
  */
 #define EMMC_0_CLK_RATE_HZ         (26U * 1000U * 1000U)
+#define EMMC_0_HS_CLK_RATE_HZ      (200U * 1000U * 1000U)
 #define EMMC_0_BUS_WIDTH           MMC_BUS_WIDTH_8
 
 /*
@@ -98,7 +98,9 @@ BL2_SOURCES		+=	${DDR_SOURCES} \
 				plat/adi/adrv/adrv906x/adrv906x_security.c \
 				plat/adi/adrv/adrv906x/adrv906x_wdt.c
 ifeq (${DEBUG},1)
-BL2_SOURCES		+=	plat/adi/adrv/adrv906x/adrv906x_cli.c
+BL2_SOURCES		+=	plat/adi/adrv/adrv906x/aarch64/adrv906x_ddr_mem_test_entry.S \
+				plat/adi/adrv/adrv906x/adrv906x_cli.c \
+				plat/adi/adrv/adrv906x/adrv906x_ddr_mem_test.c
 endif
 
 BL31_SOURCES	+=	drivers/adi/adrv906x/clk/clk.c \
@@ -136,5 +138,10 @@ ifeq (${SECONDARY_LINUX_ENABLED}, 1)
 $(eval $(call add_defines, SECONDARY_LINUX_ENABLED))
 endif
 
+# Run the DDR controller scrubber BIST over the whole DDR at boot (adds boot time)
+ifeq (${DDR_BIST_AT_BOOT}, 1)
+$(eval $(call add_defines, DDR_BIST_AT_BOOT))
+endif
+
 # Add argument for secondary image binary
 $(eval $(call add_defines, SECONDARY_IMAGE_BIN))
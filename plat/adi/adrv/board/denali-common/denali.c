@@ -86,6 +86,8 @@ uint8_t erase_buffer[BUFFER_SIZE];
 int plat_get_nor_data(struct nor_device *device)
 {
 	device->size = SZ_128M;
+	/* Let SFDP pick the read mode and 4-byte opcodes */
+	device->flags |= SPI_NOR_USE_SFDP;
 
 	zeromem(&device->read_op, sizeof(struct spi_mem_op));
 	/* Read Operation */
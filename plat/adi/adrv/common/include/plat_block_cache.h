@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLAT_BLOCK_CACHE_H
+#define PLAT_BLOCK_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <drivers/io/io_block.h>
+
+void plat_block_cache_init(const io_block_ops_t *dev_ops, size_t block_size);
+size_t plat_block_cache_read(int lba, uintptr_t buf, size_t size);
+size_t plat_block_cache_write(int lba, const uintptr_t buf, size_t size);
+void plat_block_cache_get_stats(uint32_t *hits, uint32_t *misses);
+
+#endif /* PLAT_BLOCK_CACHE_H */
@@ -31,6 +31,9 @@
 #define FIP_PARTITION_NAME_SIZE 6               /* fip_a/fip_b + null */
 #define FIP_PARTITION_BASE_NAME "fip_"
 
+/* FIP ToC entries indexed by io_fip on device init (the ADI FIP has about 20) */
+#define FIP_TOC_INDEX_MAX_ENTRIES       32
+
 /*
  * Bootctrl related constants
  */
@@ -105,6 +108,19 @@
 #define HW_CONFIG_BASE                  (NS_DRAM_BASE)                                  /* Place HW_CONFIG at the beginning of NS_DRAM */
 #define HW_CONFIG_LIMIT                 (HW_CONFIG_BASE + HW_CONFIG_MAX_SIZE)
 
+/*
+ * Block cache defines (eMMC/SD boot device).
+ */
+#ifndef PLAT_BLOCK_CACHE_LINES
+#define PLAT_BLOCK_CACHE_LINES          U(4)
+#endif
+#ifndef PLAT_BLOCK_CACHE_LINE_SIZE
+#define PLAT_BLOCK_CACHE_LINE_SIZE      UL(0x1000)                              /* 4KB read-ahead per miss */
+#endif
+#ifndef PLAT_BL2_MMC_BUFFER_SIZE
+#define PLAT_BL2_MMC_BUFFER_SIZE        UL(0x10000)                             /* 64KB per read, one ADMA2 descriptor */
+#endif
+
 /*
  * BL1 specific defines.
  */
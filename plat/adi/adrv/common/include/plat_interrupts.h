@@ -11,14 +11,27 @@
 #include <bl31/interrupt_mgmt.h>
 
 #include <platform.h>
+#include <plat_sip_svc.h>
 
 #define MAX_INTR_EL3    1024
 
+/* Number of interrupt IDs whose dispatches can be recorded with PLAT_INTR_STATS */
+#define PLAT_INTR_STATS_MAX_IDS 64
+
+/* Number of interrupt IDs that can be rate limited */
+#define PLAT_INTR_THROTTLE_MAX_IDS 24
+
 int plat_request_intr_type_el3(uint32_t id, interrupt_type_handler_t handler);
+int plat_throttle_intr_type_el3(uint32_t id, uint32_t burst, uint32_t rate, uint32_t backoff_ms);
+void plat_intr_throttle_poll(void);
 #if EL3_EXCEPTION_HANDLING
 int plat_interrupt_handler(uint32_t intr_raw, uint32_t flags, void *handle, void *cookie);
 #else
 uint64_t plat_interrupt_handler(uint32_t intr_raw, uint32_t flags, void *handle, void *cookie);
 #endif
 
+#ifdef PLAT_INTR_STATS
+uintptr_t plat_intr_stats_smc_handler(unsigned int smc_fid, u_register_t x1, u_register_t x2, u_register_t x3, u_register_t x4, void *cookie, void *handle, u_register_t flags);
+#endif
+
 #endif /* PLAT_INTERRUPTS_H */
@@ -46,6 +46,15 @@ bool plat_secure_pinctrl_get(plat_pinctrl_settings *settings, const bool secure_
  */
 bool plat_secure_pinctrl_set_group(const plat_pinctrl_settings pin_group_settings[], const size_t pin_grp_members, const bool secure_access, uintptr_t base_addr);
 
+/**
+ *	Pinmux batch set function, validates and applies count settings in one call
+ *		applied[i] is set to true for each entry that was applied, the others
+ *		are left unchanged in hardware. Returns true if every entry was applied.
+ *		secure_access = true when request originates from secure_world
+ *
+ */
+bool plat_secure_pinctrl_set_batch(const plat_pinctrl_settings settings[], bool applied[], const size_t count, const bool secure_access, uintptr_t base_addr);
+
 /**
  *	Pinmux GPIO-to-Pin mapping function.
  *		the parameters define which GPIO, i.e., "GPIO_S_5" would be (5, true)
@@ -11,7 +11,22 @@
 
 #include <plat_sip_svc.h>
 
+/* Maximum number of entries in one SET_BATCH request */
+#define PLAT_PINCTRL_BATCH_MAX          64U
 
+/*
+ * SET_BATCH entry, an array of these is passed in normal world memory.
+ * flags uses the same bits as argument 5 of SET. status is written back
+ * by the handler: 1 if the entry was applied, 0 otherwise.
+ */
+typedef struct {
+	uint32_t pin_pad;
+	uint32_t src_mux;
+	uint32_t drive_strength;
+	uint32_t flags;
+	uint32_t extended_options;
+	uint32_t status;
+} plat_pinctrl_batch_entry_t;
 
 uintptr_t plat_pinctrl_smc_handler(unsigned int smc_fid, u_register_t x1, u_register_t x2, u_register_t x3, u_register_t x4, void *cookie, void *handle, u_register_t flags);
 
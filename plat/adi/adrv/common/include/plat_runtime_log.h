@@ -7,7 +7,10 @@
 #ifndef PLAT_RUNTIME_LOG_H
 #define PLAT_RUNTIME_LOG_H
 
+#include <stdint.h>
+
 void write_to_runtime_buffer(const char *message);
 void read_from_runtime_buffer(char *message, int size);
+void get_runtime_buffer_stats(uint32_t *dropped, uint32_t *high_water);
 
 #endif /* PLAT_RUNTIME_LOG_H */
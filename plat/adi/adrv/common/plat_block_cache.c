@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025, Analog Devices Incorporated, All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <common/debug.h>
+#include <lib/utils_def.h>
+
+#include <plat_block_cache.h>
+#include <platform_def.h>
+
+/*
+ * LRU cache of block device reads, placed between io_block and the
+ * block driver. io_block rounds each read to whole blocks, so every GPT,
+ * FIP TOC or certificate access becomes a small block device read.
+ * Misses fetch a whole line (aligned group of blocks) at once, which both
+ * serves re-reads of the same blocks and reads ahead for sequential loads.
+ * Reads spanning several whole lines (image loads through the multi-block
+ * BL2 bounce buffer) bypass the cache, so the device sees one large transfer.
+ */
+#define LINE_EMPTY      (-1)
+
+CASSERT((PLAT_BLOCK_CACHE_LINE_SIZE % CACHE_WRITEBACK_GRANULE) == 0U, assert_block_cache_line_size);
+
+static uint8_t cache_data[PLAT_BLOCK_CACHE_LINES][PLAT_BLOCK_CACHE_LINE_SIZE] __aligned(CACHE_WRITEBACK_GRANULE);
+static int cache_lba[PLAT_BLOCK_CACHE_LINES];           /* First block held by each line */
+static uint32_t cache_stamp[PLAT_BLOCK_CACHE_LINES];    /* Last use, for LRU eviction */
+static uint32_t use_count;
+
+static const io_block_ops_t *ops;
+static size_t blocks_per_line;
+static size_t block_size;
+
+static uint32_t hits;
+static uint32_t misses;
+
+static void invalidate_lines(int lba, size_t nblocks)
+{
+	unsigned int i;
+
+	for (i = 0U; i < PLAT_BLOCK_CACHE_LINES; i++) {
+		if ((cache_lba[i] != LINE_EMPTY) &&
+		    (cache_lba[i] < (lba + (int)nblocks)) &&
+		    ((cache_lba[i] + (int)blocks_per_line) > lba))
+			cache_lba[i] = LINE_EMPTY;
+	}
+}
+
+/* Return the line holding line_lba, filling the least recently used line on a miss */
+static int get_line(int line_lba)
+{
+	unsigned int victim = 0U;
+	unsigned int i;
+
+	for (i = 0U; i < PLAT_BLOCK_CACHE_LINES; i++) {
+		if (cache_lba[i] == line_lba) {
+			hits++;
+			cache_stamp[i] = ++use_count;
+			return (int)i;
+		}
+		if ((cache_lba[i] == LINE_EMPTY) ||
+		    ((cache_lba[victim] != LINE_EMPTY) && (cache_stamp[i] < cache_stamp[victim])))
+			victim = i;
+	}
+
+	misses++;
+	cache_lba[victim] = LINE_EMPTY;
+	if (ops->read(line_lba, (uintptr_t)cache_data[victim], PLAT_BLOCK_CACHE_LINE_SIZE) != PLAT_BLOCK_CACHE_LINE_SIZE)
+		return -1;
+
+	cache_lba[victim] = line_lba;
+	cache_stamp[victim] = ++use_count;
+
+	return (int)victim;
+}
+
+void plat_block_cache_init(const io_block_ops_t *dev_ops, size_t dev_block_size)
+{
+	unsigned int i;
+
+	assert((dev_ops != NULL) && (dev_ops->read != NULL) &&
+	       (dev_block_size != 0U) && ((PLAT_BLOCK_CACHE_LINE_SIZE % dev_block_size) == 0U));
+
+	ops = dev_ops;
+	block_size = dev_block_size;
+	blocks_per_line = PLAT_BLOCK_CACHE_LINE_SIZE / dev_block_size;
+
+	for (i = 0U; i < PLAT_BLOCK_CACHE_LINES; i++)
+		cache_lba[i] = LINE_EMPTY;
+
+	hits = 0U;
+	misses = 0U;
+}
+
+size_t plat_block_cache_read(int lba, uintptr_t buf, size_t size)
+{
+	size_t offset;
+	size_t chunk;
+	size_t direct;
+	size_t done = 0U;
+	int line_lba;
+	int line;
+
+	assert(ops != NULL);
+
+	while (done < size) {
+		line_lba = lba - (int)((size_t)lba % blocks_per_line);
+
+		direct = ((size - done) / PLAT_BLOCK_CACHE_LINE_SIZE) * PLAT_BLOCK_CACHE_LINE_SIZE;
+		if ((line_lba == lba) && (direct > PLAT_BLOCK_CACHE_LINE_SIZE)) {
+			chunk = ops->read(lba, buf + done, direct);
+			done += chunk;
+			if (chunk != direct)
+				return done;
+			lba += (int)(chunk / block_size);
+			continue;
+		}
+
+		line = get_line(line_lba);
+		if (line < 0) {
+			/* Read-ahead failed (e.g. past the end of the device), read only what was asked */
+			return done + ops->read(lba, buf + done, size - done);
+		}
+
+		offset = (size_t)(lba - line_lba) * block_size;
+		chunk = MIN(size - done, PLAT_BLOCK_CACHE_LINE_SIZE - offset);
+		memcpy((void *)(buf + done), &cache_data[line][offset], chunk);
+
+		done += chunk;
+		lba += (int)(chunk / block_size);
+	}
+
+	return done;
+}
+
+size_t plat_block_cache_write(int lba, const uintptr_t buf, size_t size)
+{
+	assert((ops != NULL) && (ops->write != NULL));
+
+	/* Write through, dropping any stale copy */
+	invalidate_lines(lba, size / block_size);
+
+	return ops->write(lba, buf, size);
+}
+
+void plat_block_cache_get_stats(uint32_t *hit_count, uint32_t *miss_count)
+{
+	*hit_count = hits;
+	*miss_count = misses;
+}
@@ -5,12 +5,14 @@
  */
 
 #include <assert.h>
+#include <stddef.h>
+#include <string.h>
 
 #include <arch.h>
 #include <arch_helpers.h>
-#include <arm_acle.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
+#include <common/tf_crc32.h>
 #include <drivers/io/io_block.h>
 #include <drivers/io/io_driver.h>
 #include <lib/mmio.h>
@@ -24,7 +26,26 @@
 /* Header info for bootctrl structure */
 #define PLAT_BOOTCTRL_CONFIG 0x0100000
 #define PLAT_BOOTCTRL_MAGIC 0xAD1B007C
-#define PLAT_BOOTCTRL_VERSION 0x00000001
+#define PLAT_BOOTCTRL_VERSION 0x00000002
+#define PLAT_BOOTCTRL_VERSION_V1 0x00000001     /* Single record at offset 0, no sequence number */
+
+/*
+ * The bootctrl partition starts with a log of fixed size records. Updates
+ * append a record to the first erased slot after the newest one, so they only
+ * program bits, and the log is erased and rewritten only once it is full.
+ * The valid version 2 record with the highest sequence number is the current
+ * one.
+ *
+ * Version 1 tools only know the single record at offset 0. A version 1
+ * record found there is authoritative: this code never leaves one beside
+ * version 2 records (the first update after reading one rewrites the log), so
+ * it can only have been written after the log by a version 1 tool. Tools that
+ * read offset 0 must be updated to read the log, as after an update it holds
+ * the oldest version 2 record.
+ */
+#define PLAT_BOOTCTRL_RECORD_SIZE 32U
+#define PLAT_BOOTCTRL_LOG_SIZE 0x800U
+#define PLAT_BOOTCTRL_ERASED 0xFFU
 
 /* Indication of invalid boot slot */
 #define INVALID_BOOT_SLOT_ID '\0'
@@ -36,15 +57,29 @@ typedef struct __packed {
 	uint32_t version;
 	/* Active Slot. */
 	uint32_t active_slot;
+	/* Incremented by every record written */
+	uint32_t sequence;
 	/* CRC32 of all bytes preceding this field. */
 	uint32_t crc32;
 } plat_bootctrl_t;
 
+/* Offset of the CRC in a version 1 record, which has no sequence number */
+#define PLAT_BOOTCTRL_V1_CRC_OFFSET offsetof(plat_bootctrl_t, sequence)
+
+CASSERT(sizeof(plat_bootctrl_t) <= PLAT_BOOTCTRL_RECORD_SIZE, assert_bootctrl_record_size);
+CASSERT((PLAT_BOOTCTRL_LOG_SIZE % PLAT_BOOTCTRL_RECORD_SIZE) == 0U, assert_bootctrl_log_size);
+
 /* Local handles of boot_dev_handle and cfg_spec to read/write from/to */
 static uintptr_t boot_dev_handle = (uintptr_t)NULL;
 static uintptr_t cfg_spec = (uintptr_t)NULL;
 static char active_boot_slot = INVALID_BOOT_SLOT_ID;
 
+/* Copy of the record log on disk, valid when log_loaded is set */
+static uint8_t log_buf[PLAT_BOOTCTRL_LOG_SIZE];
+static bool log_loaded;
+static size_t log_next;         /* Slot following the newest record */
+static uint32_t log_sequence;   /* Sequence number of the newest record */
+
 static int set_active_slot(char active_slot);
 static int do_failure_detection(uint32_t reset_cause, uint32_t reset_cause_ns);
 static int get_active_slot_from_disk(char *active_slot);
@@ -112,52 +147,142 @@ char plat_bootctrl_get_active_slot(void)
 	return active_boot_slot;
 }
 
-/* Retrieves the active boot slot from the bootctrl patition on disk */
-static int get_active_slot_from_disk(char *active_slot)
+/* Reads or writes length bytes at offset in the bootctrl partition */
+static int bootctrl_io(bool write, size_t offset, uint8_t *buf, size_t length)
 {
-	uint32_t crc = ~0u;
 	uintptr_t handle;
-	plat_bootctrl_t bootctrl;
-	size_t length_read;
+	size_t length_done = 0;
 	int result;
 
-	/* Check that boot_dev_handle and cfg_spec were set up to point to the handle and spec */
-	if ((boot_dev_handle == (uintptr_t)NULL) || (cfg_spec == (uintptr_t)NULL))
-		return -1;
-
-	/* Read the bootctrl struct from disk */
 	result = io_dev_init(boot_dev_handle, (uintptr_t)NULL);
 	if (result == 0) {
 		result = io_open(boot_dev_handle, cfg_spec, &handle);
 		if (result == 0) {
-			result = io_seek(handle, IO_SEEK_SET, 0);
-			if (result == 0)
-				result = io_read(handle, (uintptr_t)&bootctrl, sizeof(bootctrl), &length_read);
+			result = io_seek(handle, IO_SEEK_SET, (signed long long)offset);
+			if (result == 0) {
+				if (write)
+					result = io_write(handle, (uintptr_t)buf, length, &length_done);
+				else
+					result = io_read(handle, (uintptr_t)buf, length, &length_done);
+			}
 			io_close(handle);
 		}
 	}
 
-	/* Check the data for validity */
-	if (result == 0 && length_read == sizeof(bootctrl)) {
-		if (bootctrl.magic != PLAT_BOOTCTRL_MAGIC)
-			return -1;
-		if (bootctrl.version != PLAT_BOOTCTRL_VERSION)
-			return -1;
+	if (result == 0 && length_done == length)
+		return 0;
 
-		/* Calculate crc */
-		crc = __crc32w(crc, bootctrl.magic);
-		crc = __crc32w(crc, bootctrl.version);
-		crc = __crc32w(crc, bootctrl.active_slot);
-		crc = ~crc;
+	return -1;
+}
 
-		if (bootctrl.crc32 != crc)
-			return -1;
+/* Size of the record log, limited by the size of the bootctrl partition */
+static size_t bootctrl_log_size(void)
+{
+	size_t length = ((io_block_spec_t *)cfg_spec)->length;
 
-		*active_slot = (char)(bootctrl.active_slot & 0xFF);
-		return 0;
+	if (length > PLAT_BOOTCTRL_LOG_SIZE)
+		length = PLAT_BOOTCTRL_LOG_SIZE;
+
+	return length - (length % PLAT_BOOTCTRL_RECORD_SIZE);
+}
+
+/* Returns true if the record slot at buf has not been written since the log was erased */
+static bool slot_is_erased(const uint8_t *buf)
+{
+	unsigned int i;
+
+	for (i = 0U; i < PLAT_BOOTCTRL_RECORD_SIZE; i++)
+		if (buf[i] != PLAT_BOOTCTRL_ERASED)
+			return false;
+
+	return true;
+}
+
+/* Checks the record slot at buf, version 1 records are accepted with sequence number 0 */
+static bool record_is_valid(const uint8_t *buf, plat_bootctrl_t *bootctrl)
+{
+	uint32_t crc;
+
+	memcpy(bootctrl, buf, sizeof(*bootctrl));
+
+	if (bootctrl->magic != PLAT_BOOTCTRL_MAGIC)
+		return false;
+
+	if (bootctrl->version == PLAT_BOOTCTRL_VERSION_V1) {
+		memcpy(&crc, buf + PLAT_BOOTCTRL_V1_CRC_OFFSET, sizeof(crc));
+		bootctrl->sequence = 0U;
+		return tf_crc32(0U, buf, PLAT_BOOTCTRL_V1_CRC_OFFSET) == crc;
 	}
 
-	return -1;
+	if (bootctrl->version != PLAT_BOOTCTRL_VERSION)
+		return false;
+
+	return tf_crc32(0U, buf, offsetof(plat_bootctrl_t, crc32)) == bootctrl->crc32;
+}
+
+/* Retrieves the active boot slot from the newest record in the bootctrl patition on disk */
+static int get_active_slot_from_disk(char *active_slot)
+{
+	plat_bootctrl_t bootctrl;
+	plat_bootctrl_t newest = { 0 };
+	plat_bootctrl_t v1 = { 0 };
+	size_t log_size;
+	size_t offset;
+	bool found = false;
+	bool v1_found = false;
+
+	log_loaded = false;
+
+	/* Check that boot_dev_handle and cfg_spec were set up to point to the handle and spec */
+	if ((boot_dev_handle == (uintptr_t)NULL) || (cfg_spec == (uintptr_t)NULL))
+		return -1;
+
+	log_size = bootctrl_log_size();
+	if (log_size == 0U)
+		return -1;
+
+	/* Read the whole record log from disk */
+	if (bootctrl_io(false, 0U, log_buf, log_size) != 0)
+		return -1;
+	log_loaded = true;
+
+	/* Find the newest valid record */
+	for (offset = 0U; offset < log_size; offset += PLAT_BOOTCTRL_RECORD_SIZE) {
+		if (!record_is_valid(&log_buf[offset], &bootctrl))
+			continue;
+		if (bootctrl.version == PLAT_BOOTCTRL_VERSION_V1) {
+			/* Version 1 tools only write offset 0 */
+			if (offset == 0U) {
+				v1 = bootctrl;
+				v1_found = true;
+			}
+			continue;
+		}
+		if (!found || (bootctrl.sequence > newest.sequence)) {
+			newest = bootctrl;
+			log_next = offset + PLAT_BOOTCTRL_RECORD_SIZE;
+			found = true;
+		}
+	}
+
+	/* A version 1 record is newer than the log, and is dropped by the next update */
+	if (v1_found) {
+		if (found && (v1.active_slot != newest.active_slot))
+			NOTICE("Bootctrl version 1 record overrides the record log\n");
+		newest.active_slot = v1.active_slot;
+		log_next = log_size;
+		found = true;
+	}
+
+	if (!found) {
+		log_loaded = false;
+		return -1;
+	}
+
+	log_sequence = newest.sequence;
+	*active_slot = (char)(newest.active_slot & 0xFF);
+
+	return 0;
 }
 
 /*
@@ -167,10 +292,9 @@ static int get_active_slot_from_disk(char *active_slot)
  */
 static int set_active_slot(char active_slot)
 {
+	uint8_t record[PLAT_BOOTCTRL_RECORD_SIZE];
 	plat_bootctrl_t bootctrl;
-	unsigned long crc = ~0u;
-	uintptr_t handle;
-	size_t length_write = 0;
+	size_t log_size;
 	int result;
 
 	if ((active_slot < BOOTCTRL_ACTIVE_SLOT_START) ||
@@ -187,34 +311,42 @@ static int set_active_slot(char active_slot)
 	if ((boot_dev_handle == (uintptr_t)NULL) || (cfg_spec == (uintptr_t)NULL))
 		return -1;
 
-	/* Setup bootctrl structure */
+	log_size = bootctrl_log_size();
+	if (log_size == 0U)
+		return -1;
+
+	/* Setup bootctrl structure, unused bytes are left erased */
 	bootctrl.magic = PLAT_BOOTCTRL_MAGIC;
 	bootctrl.version = PLAT_BOOTCTRL_VERSION;
 	bootctrl.active_slot = (uint32_t)active_slot;
+	bootctrl.sequence = log_loaded ? (log_sequence + 1U) : 0U;
+	bootctrl.crc32 = tf_crc32(0U, (const unsigned char *)&bootctrl, offsetof(plat_bootctrl_t, crc32));
+	memset(record, PLAT_BOOTCTRL_ERASED, sizeof(record));
+	memcpy(record, &bootctrl, sizeof(bootctrl));
+
+	if (log_loaded && (log_next < log_size) && slot_is_erased(&log_buf[log_next])) {
+		/* Append the record after the newest one */
+		result = bootctrl_io(true, log_next, record, sizeof(record));
+		memcpy(&log_buf[log_next], record, sizeof(record));
+	} else {
+		/* Log full or unreadable, rewrite it with this record first */
+		memset(log_buf, PLAT_BOOTCTRL_ERASED, log_size);
+		memcpy(log_buf, record, sizeof(record));
+		log_next = 0U;
+		result = bootctrl_io(true, 0U, log_buf, log_size);
+	}
 
-	/* Calculate and set crc */
-	crc = __crc32w(crc, bootctrl.magic);
-	crc = __crc32w(crc, bootctrl.version);
-	crc = __crc32w(crc, bootctrl.active_slot);
-	crc = ~crc;
-	bootctrl.crc32 = crc;
-
-	/* Write boot partition block to disk */
-	result = io_dev_init(boot_dev_handle, (uintptr_t)NULL);
-	if (result == 0) {
-		result = io_open(boot_dev_handle, cfg_spec, &handle);
-		if (result == 0) {
-			result = io_seek(handle, IO_SEEK_SET, 0);
-			if (result == 0)
-				result = io_write(handle, (uintptr_t)&bootctrl, sizeof(bootctrl), &length_write);
-			io_close(handle);
-		}
+	if (result != 0) {
+		/* The slot may be partly written, rewrite the whole log next time */
+		log_loaded = false;
+		return -1;
 	}
 
-	if (result == 0 && length_write == sizeof(bootctrl))
-		return 0;
+	log_loaded = true;
+	log_next += PLAT_BOOTCTRL_RECORD_SIZE;
+	log_sequence = bootctrl.sequence;
 
-	return -1;
+	return 0;
 }
 
 /* Set up new bootctrl slot.
@@ -13,6 +13,18 @@ ifeq (${RMA_CLI}, 1)
 $(eval $(call add_define,RMA_CLI))
 endif
 
+# Hash images as they are read, instead of in a second pass when authenticating or measuring them
+HASH_WHILE_LOADING ?= 1
+ifeq (${HASH_WHILE_LOADING}, 1)
+$(eval $(call add_define,HASH_WHILE_LOADING))
+endif
+
+# Record per interrupt dispatch statistics in BL31, readable through PLAT_SIP_SVC_INTR_STATS
+PLAT_INTR_STATS ?= 0
+ifeq (${PLAT_INTR_STATS}, 1)
+$(eval $(call add_define,PLAT_INTR_STATS))
+endif
+
 PLAT_PARTITION_MAX_ENTRIES := 32
 $(eval $(call add_define,PLAT_PARTITION_MAX_ENTRIES))
 
@@ -88,7 +100,8 @@ ifeq (${TEST_FRAMEWORK}, 1)
 PLAT_BL_COMMON_SOURCES	+=	drivers/adi/test/test_framework.c
 endif
 
-BL1_SOURCES		+=	plat/adi/adrv/common/plat_bl1_setup.c \
+BL1_SOURCES		+=	lib/locks/exclusive/aarch64/spinlock.S \
+				plat/adi/adrv/common/plat_bl1_setup.c \
 				plat/adi/adrv/common/plat_runtime_log.c
 
 ifeq (${RMA_CLI}, 1)
@@ -104,6 +117,7 @@ BL2_SOURCES		+=	common/desc_image_load.c \
 				drivers/arm/tzc/tzc400.c \
 				plat/adi/adrv/common/aarch64/plat_bl2_mem_params_desc.c \
 				plat/adi/adrv/common/plat_bl2_setup.c \
+				plat/adi/adrv/common/plat_block_cache.c \
 				plat/adi/adrv/common/plat_image_load.c \
 				plat/adi/adrv/common/plat_runtime_log.c \
 				plat/adi/adrv/common/plat_security.c
@@ -6,9 +6,68 @@
 
 #include <assert.h>
 #include <common/bl_common.h>
+#include <common/debug.h>
 #include <common/desc_image_load.h>
+#include <drivers/adi/adi_qspi.h>
+#include <drivers/auth/auth_mod.h>
+#include <drivers/adi/adi_sdhci.h>
 #include <plat/common/platform.h>
 
+#include <plat_block_cache.h>
+
+/* Read statistics of each boot device sampled before the image currently being loaded */
+static uint64_t qspi_rx_bytes;
+static uint64_t qspi_rx_ticks;
+static uint64_t mmc_rx_bytes;
+static uint64_t mmc_rx_ticks;
+
+/* Report the read throughput achieved on a boot device while loading an image */
+static void report_read_rate(unsigned int image_id, const char *dev, uint64_t bytes, uint64_t ticks)
+{
+	uint64_t rate;
+
+	if ((bytes == 0U) || (ticks == 0U))
+		return;
+
+	/* Hundredths of a MB/s */
+	rate = (bytes * 100U * plat_get_syscnt_freq2()) / (ticks * 1024U * 1024U);
+	INFO("BL2: Image id=%u read %lu bytes from %s at %lu.%02lu MB/s\n",
+	     image_id, bytes, dev, rate / 100U, rate % 100U);
+}
+
+int bl2_plat_handle_pre_image_load(unsigned int image_id)
+{
+	adi_qspi_get_rx_stats(&qspi_rx_bytes, &qspi_rx_ticks);
+	adi_mmc_get_read_stats(&mmc_rx_bytes, &mmc_rx_ticks);
+
+	return 0;
+}
+
+int bl2_plat_handle_post_image_load(unsigned int image_id)
+{
+	uint64_t bytes;
+	uint64_t ticks;
+	uint32_t hits;
+	uint32_t misses;
+
+	adi_qspi_get_rx_stats(&bytes, &ticks);
+	report_read_rate(image_id, "QSPI", bytes - qspi_rx_bytes, ticks - qspi_rx_ticks);
+
+	adi_mmc_get_read_stats(&bytes, &ticks);
+	report_read_rate(image_id, "MMC", bytes - mmc_rx_bytes, ticks - mmc_rx_ticks);
+
+	plat_block_cache_get_stats(&hits, &misses);
+	if ((hits + misses) != 0U)
+		VERBOSE("BL2: Block cache %u hits, %u misses\n", hits, misses);
+
+#if TRUSTED_BOARD_BOOT
+	VERBOSE("BL2: %u parent certificate verifications skipped, already authenticated\n",
+		auth_mod_get_parent_cache_hits());
+#endif
+
+	return 0;
+}
+
 void plat_flush_next_bl_params(void)
 {
 	flush_bl_params_desc();
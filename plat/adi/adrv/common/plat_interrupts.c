@@ -3,11 +3,247 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <stdbool.h>
+
+#include <arch_helpers.h>
+#include <drivers/arm/gic_common.h>
+#include <lib/mmio.h>
+#include <lib/spinlock.h>
+
+#include <platform_def.h>
+#include <plat_err.h>
 #include <plat_interrupts.h>
 
+#ifdef PLAT_INTR_STATS
+#include <common/runtime_svc.h>
+#include <lib/smccc.h>
+#endif
+
 /*TODO: Find a better way to store and lookup the interrupt handlers*/
 interrupt_type_handler_t type_el3_interrupt_table[MAX_INTR_EL3];
 
+#ifdef PLAT_INTR_STATS
+/*
+ * Dispatch statistics, in generic timer ticks, for each interrupt ID with a
+ * registered handler. Slots are handed out in registration order. Updates are
+ * not locked: an ID is only taken by one core at a time.
+ */
+typedef struct {
+	uint32_t id;
+	uint32_t count;
+	uint64_t min;
+	uint64_t max;
+	uint64_t total;
+} plat_intr_stats_t;
+
+static plat_intr_stats_t intr_stats[PLAT_INTR_STATS_MAX_IDS];
+static uint8_t intr_stats_slot[MAX_INTR_EL3];   /* Slot + 1, 0 if the ID is not recorded */
+static unsigned int intr_stats_count;
+
+static void intr_stats_reset(plat_intr_stats_t *stats)
+{
+	stats->count = 0U;
+	stats->min = UINT64_MAX;
+	stats->max = 0U;
+	stats->total = 0U;
+}
+
+static void intr_stats_add(uint32_t id)
+{
+	if (intr_stats_count >= PLAT_INTR_STATS_MAX_IDS)
+		return;
+
+	intr_stats[intr_stats_count].id = id;
+	intr_stats_reset(&intr_stats[intr_stats_count]);
+	intr_stats_count++;
+	intr_stats_slot[id] = (uint8_t)intr_stats_count;
+}
+
+static void intr_stats_record(uint32_t id, uint64_t start)
+{
+	plat_intr_stats_t *stats;
+	uint64_t ticks = read_cntpct_el0() - start;
+
+	if ((id >= MAX_INTR_EL3) || (intr_stats_slot[id] == 0U))
+		return;
+
+	stats = &intr_stats[intr_stats_slot[id] - 1U];
+	stats->count++;
+	stats->total += ticks;
+	if (ticks < stats->min)
+		stats->min = ticks;
+	if (ticks > stats->max)
+		stats->max = ticks;
+}
+
+/*
+ * Returns the statistics of slot x1: interrupt ID, dispatch count, and the
+ * minimum, maximum and total dispatch time in generic timer ticks.
+ * The slot is cleared after reading if x2 is non-zero.
+ */
+uintptr_t plat_intr_stats_smc_handler(unsigned int smc_fid, u_register_t x1, u_register_t x2, u_register_t x3, u_register_t x4, void *cookie, void *handle, u_register_t flags)
+{
+	plat_intr_stats_t stats;
+
+	if (x1 >= intr_stats_count)
+		SMC_RET1(handle, SMC_UNK);
+
+	stats = intr_stats[x1];
+	if (x2 != 0U)
+		intr_stats_reset(&intr_stats[x1]);
+
+	if (stats.count == 0U)
+		stats.min = 0U;
+
+	SMC_RET6(handle, SMC_OK, stats.id, stats.count, stats.min, stats.max, stats.total);
+}
+#endif
+
+/*
+ * Token bucket rate limiting of interrupt sources that can fire in storms,
+ * e.g. corrected error reports. The bucket holds up to burst events and
+ * refills at rate events per second. Credit is kept in timer ticks, an event
+ * costs one refill period. A source that runs out of credit is masked in the
+ * GIC, and unmasked by plat_intr_throttle_poll() once its back-off has passed,
+ * with a runtime log entry summarizing the events seen. There is no timer EL3
+ * owns (CNTPS belongs to S-EL1 with OP-TEE), so back-offs end lazily: the poll
+ * runs on every EL3 interrupt and SiP call.
+ */
+typedef struct {
+	uint32_t id;
+	bool masked;
+	uint32_t events;        /* Since the last summary */
+	uint32_t suppressed;    /* While masked */
+	uint64_t cost;          /* Ticks of credit per event */
+	uint64_t capacity;      /* Ticks of credit for a full bucket */
+	uint64_t credit;
+	uint64_t last;
+	uint64_t backoff;
+	uint64_t unmask_at;
+} plat_intr_throttle_t;
+
+static plat_intr_throttle_t intr_throttle[PLAT_INTR_THROTTLE_MAX_IDS];
+static uint8_t intr_throttle_slot[MAX_INTR_EL3];        /* Slot + 1, 0 if the ID is not throttled */
+static unsigned int intr_throttle_count;
+static unsigned int intr_throttle_masked;
+static spinlock_t intr_throttle_lock;
+
+/* A masked SPI still latches one pending event in the GIC */
+static bool intr_throttle_pending(uint32_t id)
+{
+	uint32_t ispendr;
+
+	if (id < MIN_SPI_ID)
+		return false;
+
+	ispendr = mmio_read_32(PLAT_GICD_BASE + GICD_ISPENDR + ((id >> ISPENDR_SHIFT) << 2));
+	return (ispendr & BIT_32(id & ((1U << ISPENDR_SHIFT) - 1U))) != 0U;
+}
+
+/* Charges one event to a throttled source, masking it if it is out of credit */
+static void intr_throttle_event(uint32_t id)
+{
+	plat_intr_throttle_t *throttle;
+	uint64_t now;
+
+	if ((id >= MAX_INTR_EL3) || (intr_throttle_slot[id] == 0U))
+		return;
+
+	throttle = &intr_throttle[intr_throttle_slot[id] - 1U];
+	now = read_cntpct_el0();
+
+	spin_lock(&intr_throttle_lock);
+
+	throttle->events++;
+	throttle->credit += now - throttle->last;
+	if (throttle->credit > throttle->capacity)
+		throttle->credit = throttle->capacity;
+	throttle->last = now;
+
+	if (throttle->masked) {
+		/* Already in flight when the source was masked */
+		throttle->suppressed++;
+	} else if (throttle->credit >= throttle->cost) {
+		throttle->credit -= throttle->cost;
+	} else {
+		plat_ic_disable_interrupt(id);
+		throttle->masked = true;
+		throttle->suppressed = 0U;
+		throttle->unmask_at = now + throttle->backoff;
+		intr_throttle_masked++;
+		plat_runtime_warn_message("Interrupt %u throttled, %u events since it was last throttled", id, throttle->events);
+		throttle->events = 0U;
+	}
+
+	spin_unlock(&intr_throttle_lock);
+}
+
+void plat_intr_throttle_poll(void)
+{
+	plat_intr_throttle_t *throttle;
+	uint64_t now;
+	unsigned int i;
+
+	if (intr_throttle_masked == 0U)
+		return;
+
+	now = read_cntpct_el0();
+
+	spin_lock(&intr_throttle_lock);
+
+	for (i = 0U; i < intr_throttle_count; i++) {
+		throttle = &intr_throttle[i];
+		if (!throttle->masked || (now < throttle->unmask_at))
+			continue;
+
+		if (intr_throttle_pending(throttle->id))
+			throttle->suppressed++;
+
+		throttle->masked = false;
+		throttle->credit = throttle->capacity;
+		throttle->last = now;
+		intr_throttle_masked--;
+		plat_ic_enable_interrupt(throttle->id);
+		plat_runtime_warn_message("Interrupt %u unmasked, %u events suppressed while masked", throttle->id, throttle->suppressed);
+	}
+
+	spin_unlock(&intr_throttle_lock);
+}
+
+/*
+ * Rate limits interrupt id to a burst of burst events, refilled at rate events
+ * per second. Once exceeded, the interrupt is masked for backoff_ms.
+ */
+int plat_throttle_intr_type_el3(uint32_t id, uint32_t burst, uint32_t rate, uint32_t backoff_ms)
+{
+	plat_intr_throttle_t *throttle;
+	uint64_t freq = plat_get_syscnt_freq2();
+
+	if ((id >= MAX_INTR_EL3) || (burst == 0U) || (rate == 0U))
+		return -EINVAL;
+
+	if (intr_throttle_slot[id] != 0U)
+		return -EALREADY;
+
+	if (intr_throttle_count >= PLAT_INTR_THROTTLE_MAX_IDS)
+		return -ENOMEM;
+
+	throttle = &intr_throttle[intr_throttle_count];
+	throttle->id = id;
+	throttle->masked = false;
+	throttle->events = 0U;
+	throttle->suppressed = 0U;
+	throttle->cost = freq / rate;
+	throttle->capacity = throttle->cost * burst;
+	throttle->credit = throttle->capacity;
+	throttle->last = read_cntpct_el0();
+	throttle->backoff = (freq * backoff_ms) / 1000U;
+	intr_throttle_count++;
+	intr_throttle_slot[id] = (uint8_t)intr_throttle_count;
+
+	return 0;
+}
+
 int plat_request_intr_type_el3(uint32_t id, interrupt_type_handler_t handler)
 {
 	/* Validate 'handler' and 'id' parameters */
@@ -20,6 +256,10 @@ int plat_request_intr_type_el3(uint32_t id, interrupt_type_handler_t handler)
 
 	type_el3_interrupt_table[id] = handler;
 
+#ifdef PLAT_INTR_STATS
+	intr_stats_add(id);
+#endif
+
 	return 0;
 }
 
@@ -28,12 +268,22 @@ int plat_interrupt_handler(uint32_t intr_raw, uint32_t flags, void *handle, void
 {
 	int ret = 0;
 	interrupt_type_handler_t handler;
+#ifdef PLAT_INTR_STATS
+	uint64_t start = read_cntpct_el0();
+#endif
+
+	plat_intr_throttle_poll();
 
 	handler = type_el3_interrupt_table[intr_raw];
 	if (handler != NULL)
 		ret = handler(intr_raw, flags, handle, cookie);
+	intr_throttle_event(intr_raw);
 
 	plat_ic_end_of_interrupt(intr_raw);
+
+#ifdef PLAT_INTR_STATS
+	intr_stats_record(intr_raw, start);
+#endif
 	return ret;
 }
 #else
@@ -42,14 +292,24 @@ uint64_t plat_interrupt_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 	int ret = 0;
 	uint32_t int_id;
 	interrupt_type_handler_t handler;
+#ifdef PLAT_INTR_STATS
+	uint64_t start = read_cntpct_el0();
+#endif
+
+	plat_intr_throttle_poll();
 
 	int_id = plat_ic_get_pending_interrupt_id();
 	handler = type_el3_interrupt_table[int_id];
 	if (handler != NULL)
 		ret = handler(int_id, flags, handle, cookie);
+	intr_throttle_event(int_id);
 
 	plat_ic_clear_interrupt_pending(int_id);
 	plat_ic_end_of_interrupt(int_id);
+
+#ifdef PLAT_INTR_STATS
+	intr_stats_record(int_id, start);
+#endif
 	return ret;
 }
 #endif
@@ -27,6 +27,9 @@
 #include <platform.h>
 #include <tools_share/firmware_image_package.h>
 
+#ifdef IMAGE_BL2
+#include <plat_block_cache.h>
+#endif
 #include <plat_board.h>
 #include <plat_boot.h>
 #include <plat_bootctrl.h>
@@ -34,7 +37,12 @@
 #include <plat_err.h>
 #include <plat_io_storage.h>
 
+/* BL2 loads the images, its larger buffer lets io_block read many blocks per transfer */
+#ifdef IMAGE_BL2
+#define PLAT_MMC_BUFFER_SIZE    (PLAT_BL2_MMC_BUFFER_SIZE)
+#else
 #define PLAT_MMC_BUFFER_SIZE    (MMC_BLOCK_SIZE)
+#endif
 
 #define PLAT_FIP_BASE           (0)
 #define PLAT_FIP_MAX_SIZE       (0x1000000)
@@ -50,7 +58,7 @@ CASSERT(BL33_BASE >= NS_DRAM_BASE, BL33_BASE_not_in_NS_DRAM);
 static const io_dev_connector_t *fip_dev_con;
 static const io_dev_connector_t *boot_dev_con;
 
-static uint8_t mmc_block_buffer[PLAT_MMC_BUFFER_SIZE] __aligned(PLAT_MMC_BUFFER_SIZE);
+static uint8_t mmc_block_buffer[PLAT_MMC_BUFFER_SIZE] __aligned(MMC_BLOCK_SIZE);
 
 static uintptr_t fip_dev_handle;
 static uintptr_t boot_dev_handle;
@@ -98,6 +106,9 @@ static int check_fip(const uintptr_t spec);
 static int check_dev(const uintptr_t spec);
 
 static io_block_dev_spec_t boot_dev_spec;
+#ifdef IMAGE_BL2
+static io_block_ops_t mmc_dev_ops;
+#endif
 static int (*register_io_dev)(const io_dev_connector_t **);
 static io_mtd_dev_spec_t spi_nor_dev_spec;
 
@@ -272,8 +283,17 @@ void plat_io_setup(bool use_bootctrl, uint32_t reset_cause, uint32_t reset_cause
 		register_io_dev = &register_io_dev_block;
 		boot_dev_spec.buffer.offset = (size_t)mmc_block_buffer;
 		boot_dev_spec.buffer.length = PLAT_MMC_BUFFER_SIZE;
+#ifdef IMAGE_BL2
+		/* BL2 loads most images, read through the block cache */
+		mmc_dev_ops.read = mmc_read_blocks;
+		mmc_dev_ops.write = mmc_write_blocks;
+		plat_block_cache_init(&mmc_dev_ops, MMC_BLOCK_SIZE);
+		boot_dev_spec.ops.read = plat_block_cache_read;
+		boot_dev_spec.ops.write = plat_block_cache_write;
+#else
 		boot_dev_spec.ops.read = mmc_read_blocks;
 		boot_dev_spec.ops.write = mmc_write_blocks;
+#endif
 		boot_dev_spec.block_size = MMC_BLOCK_SIZE;
 		break;
 
@@ -4,11 +4,16 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <errno.h>
 #include <stdint.h>
 
+#include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <lib/spinlock.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
 
+#include <plat_device_profile.h>
 #include <plat_err.h>
 #include <plat_pinctrl.h>
 #include <plat_pinctrl_svc.h>
@@ -44,9 +49,101 @@
 typedef enum {
 	INIT	= 0,
 	SET	= 1,
-	GET	= 2
+	GET	= 2,
+	SET_BATCH = 3
 } func_id_t;
 
+static plat_pinctrl_settings batch_settings[PLAT_PINCTRL_BATCH_MAX];
+static bool batch_applied[PLAT_PINCTRL_BATCH_MAX];
+static spinlock_t batch_lock;
+
+static void flags_to_settings(u_register_t flags, plat_pinctrl_settings *settings)
+{
+	settings->schmitt_trigger_enable = (flags & PINCTRL_x5_BIT_PIN_ST) != 0x00U;
+	settings->pullup_pulldown_enablement = (flags & PINCTRL_x5_BIT_PIN_ENABLE_PU_PD) != 0x00U;
+	settings->pullup = (flags & PINCTRL_x5_BIT_PIN_PU_PD_SEL) != 0x00U;
+}
+
+/* The entry buffer must lie wholly within normal world DRAM */
+static bool batch_buffer_is_valid(uintptr_t buf, size_t size)
+{
+	uintptr_t ns_dram_end = NS_DRAM_BASE + (plat_get_dram_size() - TEE_DRAM_SIZE);
+
+	return (buf >= NS_DRAM_BASE) && (buf < ns_dram_end) && (size <= (ns_dram_end - buf));
+}
+
+/*
+ * Applies count entries from the normal world buffer at buf in one call,
+ * writing back each entry's status and the number of entries applied.
+ * The buffer is mapped, used and unmapped under batch_lock. A buffer inside
+ * the HW_CONFIG region uses its static mapping, one partially overlapping it
+ * cannot be mapped on its own and is rejected.
+ */
+static int set_batch(uintptr_t buf, size_t count, bool secure_access, uintptr_t base_addr, bool *all_applied, size_t *applied)
+{
+	plat_pinctrl_batch_entry_t *entries = (plat_pinctrl_batch_entry_t *)buf;
+	size_t size = count * sizeof(plat_pinctrl_batch_entry_t);
+	uintptr_t base_aligned;
+	size_t size_aligned;
+	bool mapped = false;
+	size_t i;
+	int rc = 0;
+
+	*all_applied = false;
+	*applied = 0U;
+
+	if ((count == 0U) || (count > PLAT_PINCTRL_BATCH_MAX) || !batch_buffer_is_valid(buf, size)) {
+		plat_runtime_warn_message("PINCTRL service: Invalid batch buffer");
+		return -EINVAL;
+	}
+
+	/* The buffer may straddle pages, so round both ends */
+	base_aligned = page_align(buf, DOWN);
+	size_aligned = page_align(buf + size, UP) - base_aligned;
+
+	spin_lock(&batch_lock);
+
+	if ((base_aligned < HW_CONFIG_BASE) || ((base_aligned + size_aligned) > HW_CONFIG_LIMIT)) {
+		if ((base_aligned < HW_CONFIG_LIMIT) && ((base_aligned + size_aligned) > HW_CONFIG_BASE)) {
+			rc = -EPERM;
+			plat_runtime_warn_message("PINCTRL service: Batch buffer overlaps HW_CONFIG %d", rc);
+			goto out;
+		}
+
+		rc = mmap_add_dynamic_region((unsigned long long)base_aligned, base_aligned, size_aligned, MT_MEMORY | MT_RW | MT_NS);
+		if (rc != 0) {
+			plat_runtime_warn_message("PINCTRL service: Unable to map batch buffer %d", rc);
+			goto out;
+		}
+		mapped = true;
+	}
+
+	for (i = 0U; i < count; i++) {
+		batch_settings[i].pin_pad = entries[i].pin_pad;
+		batch_settings[i].src_mux = entries[i].src_mux;
+		batch_settings[i].drive_strength = entries[i].drive_strength;
+		batch_settings[i].extended_options = entries[i].extended_options;
+		flags_to_settings(entries[i].flags, &batch_settings[i]);
+		batch_applied[i] = false;
+	}
+
+	*all_applied = plat_secure_pinctrl_set_batch(batch_settings, batch_applied, count, secure_access, base_addr);
+
+	for (i = 0U; i < count; i++) {
+		entries[i].status = batch_applied[i] ? 1U : 0U;
+		if (batch_applied[i])
+			(*applied)++;
+	}
+
+	if (mapped)
+		mmap_remove_dynamic_region((unsigned long long)base_aligned, size_aligned);
+
+out:
+	spin_unlock(&batch_lock);
+
+	return rc;
+}
+
 /*
  * PinMUX service SMC handler
  */
@@ -88,21 +185,7 @@ uintptr_t plat_pinctrl_smc_handler(unsigned int smc_fid,
 		base_addr = (uintptr_t)x6;
 
 		settings.extended_options = x7;
-
-		if ((x5 & PINCTRL_x5_BIT_PIN_ST) == 0x00U)
-			settings.schmitt_trigger_enable = false;
-		else
-			settings.schmitt_trigger_enable = true;
-
-		if ((x5 & PINCTRL_x5_BIT_PIN_ENABLE_PU_PD) == 0x00U)
-			settings.pullup_pulldown_enablement = false;
-		else
-			settings.pullup_pulldown_enablement = true;
-
-		if ((x5 & PINCTRL_x5_BIT_PIN_PU_PD_SEL) == 0x00U)
-			settings.pullup = false;
-		else
-			settings.pullup = true;
+		flags_to_settings(x5, &settings);
 
 		result = plat_secure_pinctrl_set(settings, is_caller_secure(flags), base_addr);
 		SMC_RET2(handle, SMC_OK, result);
@@ -131,6 +214,16 @@ uintptr_t plat_pinctrl_smc_handler(unsigned int smc_fid,
 		SMC_RET4(handle, SMC_OK, result, a2, a3);
 		break;
 
+	case SET_BATCH: {
+		/* PinMUX SET_BATCH command received, x2 = entry buffer, x3 = entry count */
+		size_t applied;
+
+		/* A rejected buffer reports no entry applied */
+		(void)set_batch((uintptr_t)x2, (size_t)x3, is_caller_secure(flags), (uintptr_t)x6, &result, &applied);
+		SMC_RET3(handle, SMC_OK, result, applied);
+		break;
+	}
+
 	default:
 		plat_runtime_warn_message("PINCTRL service: Unexpected command");
 		SMC_RET1(handle, SMC_UNK);
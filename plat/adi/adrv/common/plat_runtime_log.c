@@ -4,113 +4,157 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
-#include <common/debug.h>
+#include <lib/cassert.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
+#include <platform.h>
 #include <stdbool.h>
-#include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 
 #include <plat_runtime_log.h>
+#include <platform_def.h>
 
-/* This value must match the value in optee_os/core/pta/adi/runtime_log.c */
+/*
+ * Each core owns one ring and is its only producer, so writers never
+ * contend with each other. The reader (runtime log SMC) is the only consumer
+ * of every ring. Indexes are free-running and only masked on access, so
+ * head - tail is always the number of used bytes.
+ */
+#define RUNTIME_LOG_RING_SIZE   U(512)
+#define RUNTIME_LOG_RING_MASK   (RUNTIME_LOG_RING_SIZE - 1U)
+
+/*
+ * This value must match the value in optee_os/core/pta/adi/runtime_log.c.
+ * It is the size of the buffer OP-TEE passes to the runtime log SMC, which
+ * still returns GROUP_SEPARATOR terminated records and nothing else.
+ */
 #define SIZE_OF_BL31_RUNTIME_BUFFER 500
 
+CASSERT((RUNTIME_LOG_RING_SIZE & RUNTIME_LOG_RING_MASK) == 0U, assert_runtime_log_ring_size_pow2);
+CASSERT(RUNTIME_LOG_RING_SIZE >= SIZE_OF_BL31_RUNTIME_BUFFER, assert_runtime_log_ring_size);
+
 #define GROUP_SEPARATOR '\x1D'  /* ASCII Group Separator */
 
-static int buffer_length = 0;
-static int read_index = 0;
-static char runtime_log[SIZE_OF_BL31_RUNTIME_BUFFER];
-static int write_index = 0;
-static bool lock = false;
+typedef struct {
+	uint32_t head;          /* Written by the owning core only */
+	uint32_t tail;          /* Written by the reader only */
+	uint32_t dropped;       /* Records discarded because the ring was full */
+	uint32_t high_water;    /* Largest number of bytes ever held in the ring */
+	char data[RUNTIME_LOG_RING_SIZE];
+} __aligned(CACHE_WRITEBACK_GRANULE) runtime_log_ring_t;
 
-/* Returns true if buffer is full */
-static bool is_buffer_full(void)
-{
-	if (buffer_length == SIZE_OF_BL31_RUNTIME_BUFFER) {
-		INFO("BL31 runtime buffer is full\n");
-		return true;
-	}
-	return false;
-}
+static runtime_log_ring_t runtime_log[PLATFORM_CORE_COUNT];
+
+/* Serializes readers only, writers never take it */
+static spinlock_t reader_lock;
 
-/* Writes one character to runtime buffer */
-static void write_char_to_buffer(char write)
+/* Write message to the calling core's runtime buffer */
+void write_to_runtime_buffer(const char *message)
 {
-	/* If buffer is full, cannot write to it */
-	if (is_buffer_full())
+	runtime_log_ring_t *ring;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t used;
+	size_t len;
+	size_t i;
+
+	ring = &runtime_log[plat_my_core_pos()];
+	len = strlen(message) + 1U;     /* Message plus group separator */
+
+	head = ring->head;
+	tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	used = head - tail;
+
+	/* Drop the whole record rather than storing a partial message */
+	if (len > (RUNTIME_LOG_RING_SIZE - used)) {
+		ring->dropped++;
 		return;
+	}
 
-	/* Write character to buffer, increment buffer length and write index */
-	runtime_log[write_index] = write;
-	buffer_length++;
-	write_index++;
-
-	/* Circle write index back to beginning of buffer, if past the end */
-	if (write_index == SIZE_OF_BL31_RUNTIME_BUFFER)
-		write_index = 0;
-}
-
-/* Read one character from runtime buffer */
-static char read_char_from_buffer(void)
-{
-	char read;
+	for (i = 0U; i < (len - 1U); i++)
+		ring->data[(head + i) & RUNTIME_LOG_RING_MASK] = message[i];
+	ring->data[(head + i) & RUNTIME_LOG_RING_MASK] = GROUP_SEPARATOR;
 
-	/* Read one character from buffer, increment read index, and decrement buffer length */
-	read = runtime_log[read_index];
-	read_index++;
-	buffer_length--;
+	used += len;
+	if (used > ring->high_water)
+		ring->high_water = used;
 
-	/* Circle read index back to beginning of buffer, if past the end */
-	if (read_index == SIZE_OF_BL31_RUNTIME_BUFFER)
-		read_index = 0;
-	return read;
+	/* Publish the record only after its contents are visible */
+	__atomic_store_n(&ring->head, head + len, __ATOMIC_RELEASE);
 }
 
-/* Write message to runtime buffer */
-void write_to_runtime_buffer(const char *message)
+/*
+ * Copy complete records from one ring into message. Returns the number of
+ * bytes written. A record that does not fit is left for the next read, unless
+ * the reader's buffer is empty (the record can never fit), in which case it is
+ * truncated so the ring cannot stall.
+ */
+static int drain_ring(runtime_log_ring_t *ring, char *message, int size, bool empty)
 {
-	char *tmp = (char *)message;
-
-	/* Obtain lock when available */
-	while (lock)
-		;
-	lock = true;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t end;
+	uint32_t len;
+	uint32_t i;
+	int index = 0;
 
-	/* Write each character to runtime buffer */
-	while (*tmp != '\0') {
-		write_char_to_buffer(*tmp);
-		tmp++;
+	head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	tail = ring->tail;
+
+	while (tail != head) {
+		/* Find the end of the next record */
+		end = tail;
+		while (ring->data[end & RUNTIME_LOG_RING_MASK] != GROUP_SEPARATOR)
+			end++;
+		len = end - tail + 1U;
+
+		if (len > (uint32_t)(size - index)) {
+			if (!empty || (index != 0))
+				break;
+			len = size;
+		}
+
+		for (i = 0U; i < len; i++)
+			message[index + i] = ring->data[(tail + i) & RUNTIME_LOG_RING_MASK];
+		index += len;
+		tail = end + 1U;
 	}
 
-	/* Write termination character to buffer */
-	write_char_to_buffer(GROUP_SEPARATOR);
+	/* Hand the consumed space back to the producer */
+	__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
 
-	/* Unlock */
-	lock = false;
+	return index;
 }
 
-/* Read messages from runtime buffer */
+/* Read messages from all runtime buffers */
 void read_from_runtime_buffer(char *message, int size)
 {
+	unsigned int core;
 	int index = 0;
 
-	/* Obtain lock when available */
-	while (lock)
-		;
-	lock = true;
+	spin_lock(&reader_lock);
 
-	/* Read each character into buffer */
-	while (read_index != write_index) {
+	for (core = 0U; core < PLATFORM_CORE_COUNT; core++) {
 		if (index >= size)
 			break;
-		message[index] = read_char_from_buffer();
-		index++;
+		index += drain_ring(&runtime_log[core], message + index, size - index, index == 0);
 	}
 
-	/* Clear buffer */
-	memset(runtime_log, 0, sizeof(runtime_log));
-	read_index = write_index;
-	buffer_length = 0;
+	spin_unlock(&reader_lock);
+}
+
+/* Get the total number of dropped records and the largest ring occupancy */
+void get_runtime_buffer_stats(uint32_t *dropped, uint32_t *high_water)
+{
+	unsigned int core;
+
+	*dropped = 0U;
+	*high_water = 0U;
 
-	/* Unlock */
-	lock = false;
+	for (core = 0U; core < PLATFORM_CORE_COUNT; core++) {
+		*dropped += __atomic_load_n(&runtime_log[core].dropped, __ATOMIC_RELAXED);
+		if (runtime_log[core].high_water > *high_water)
+			*high_water = runtime_log[core].high_water;
+	}
 }
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/smccc.h>
 
@@ -28,6 +29,9 @@ uintptr_t plat_runtime_log_smc_handler(unsigned int smc_fid,
 {
 	uint32_t buffer_addr = x1;
 	uint32_t size = x2;
+	uint32_t dropped;
+	uint32_t high_water;
+	static uint32_t reported_dropped;
 
 	/* Return if not a secure caller */
 	if (!is_caller_secure(flags))
@@ -37,5 +41,16 @@ uintptr_t plat_runtime_log_smc_handler(unsigned int smc_fid,
 	read_from_runtime_buffer((char *)(uintptr_t)buffer_addr, size);
 	flush_dcache_range((uintptr_t)buffer_addr, size);
 
+	/*
+	 * The SMC return values are part of the OP-TEE ABI, so overflow is
+	 * reported on the console instead, once per new batch of drops.
+	 */
+	get_runtime_buffer_stats(&dropped, &high_water);
+	if (dropped != reported_dropped) {
+		WARN("BL31 runtime log: %u records dropped, peak ring usage %u bytes\n",
+		     dropped - reported_dropped, high_water);
+		reported_dropped = dropped;
+	}
+
 	SMC_RET1(handle, SMC_OK);
 }
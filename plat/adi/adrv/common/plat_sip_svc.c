@@ -11,6 +11,7 @@
 #include <tools_share/uuid.h>
 
 #include <plat_err.h>
+#include <plat_interrupts.h>
 #include <plat_pinctrl_svc.h>
 #include <plat_pintmux_svc.h>
 #include <plat_runtime_log_svc.h>
@@ -41,6 +42,9 @@ static uintptr_t sip_handler(unsigned int smc_fid,
 			     void *handle,
 			     u_register_t flags)
 {
+	/* Unmask throttled interrupts whose back-off has expired, SiP calls such as the watchdog ping come in regularly */
+	plat_intr_throttle_poll();
+
 	/* Allow platform-specific handling of SiP first */
 	if (plat_is_plat_smc(smc_fid))
 		return plat_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
@@ -66,6 +70,11 @@ static uintptr_t sip_handler(unsigned int smc_fid,
 	case PLAT_SIP_SVC_LOG:
 		SMC_RET0(plat_runtime_log_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags));
 
+#ifdef PLAT_INTR_STATS
+	case PLAT_SIP_SVC_INTR_STATS:
+		SMC_RET0(plat_intr_stats_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags));
+#endif
+
 	default:
 		plat_runtime_warn_message("Unimplemented SiP Service Call: 0x%x ", smc_fid);
 		SMC_RET1(handle, SMC_UNK);